@@ -0,0 +1,334 @@
+/*
+ * helpers/attitude_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "attitude_helpers.h"
+/*----------------------------------------------------------------------------*/
+#define MAHONY_DEFAULT_PERIOD 8
+/*----------------------------------------------------------------------------*/
+static void makeInitialState(const Vector3f *, const Vector3f *,
+    Matrix3x3f *);
+static void makeQuaternion(const Matrix3x3f *, Quaternionf *);
+static void makeRotationMatrix(const Quaternionf *, Matrix3x3f *);
+static void matrixGetAngles(const Matrix3x3f *, float *);
+/*----------------------------------------------------------------------------*/
+static void makeInitialState(const Vector3f *acc, const Vector3f *mag,
+    Matrix3x3f *state)
+{
+  Vector3f x;
+  Vector3f y;
+  Vector3f z;
+
+  z = *acc;
+  vec3fNormalize(&z);
+
+  vec3fMakeOrthogonal(&z, mag, &x);
+  vec3fNormalize(&x);
+
+  vec3fCrossProduct(&z, &x, &y);
+  vec3fNormalize(&y);
+
+  state->x = x;
+  state->y = y;
+  state->z = z;
+}
+/*----------------------------------------------------------------------------*/
+static void makeQuaternion(const Matrix3x3f *m, Quaternionf *q)
+{
+  const float trace = m->x.x + m->y.y + m->z.z;
+
+  if (trace > 0.0f)
+  {
+    const float s = 0.5f / sqrtf(trace + 1.0f);
+
+    q->w = 0.25f / s;
+    q->x = (m->z.y - m->y.z) * s;
+    q->y = (m->x.z - m->z.x) * s;
+    q->z = (m->y.x - m->x.y) * s;
+  }
+  else if (m->x.x > m->y.y && m->x.x > m->z.z)
+  {
+    const float s = 2.0f * sqrtf(1.0f + m->x.x - m->y.y - m->z.z);
+
+    q->w = (m->z.y - m->y.z) / s;
+    q->x = 0.25f * s;
+    q->y = (m->x.y + m->y.x) / s;
+    q->z = (m->x.z + m->z.x) / s;
+  }
+  else if (m->y.y > m->z.z)
+  {
+    const float s = 2.0f * sqrtf(1.0f + m->y.y - m->x.x - m->z.z);
+
+    q->w = (m->x.z - m->z.x) / s;
+    q->x = (m->x.y + m->y.x) / s;
+    q->y = 0.25f * s;
+    q->z = (m->y.z + m->z.y) / s;
+  }
+  else
+  {
+    const float s = 2.0f * sqrtf(1.0f + m->z.z - m->x.x - m->y.y);
+
+    q->w = (m->y.x - m->x.y) / s;
+    q->x = (m->x.z + m->z.x) / s;
+    q->y = (m->y.z + m->z.y) / s;
+    q->z = 0.25f * s;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void makeRotationMatrix(const Quaternionf *q, Matrix3x3f *m)
+{
+  const float ww = q->w * q->w;
+  const float wx = q->w * q->x;
+  const float wy = q->w * q->y;
+  const float wz = q->w * q->z;
+  const float xx = q->x * q->x;
+  const float xy = q->x * q->y;
+  const float xz = q->x * q->z;
+  const float yy = q->y * q->y;
+  const float yz = q->y * q->z;
+  const float zz = q->z * q->z;
+
+  m->x = (Vector3f){ww + xx - yy - zz, 2.0f * (xy - wz), 2.0f * (xz + wy)};
+  m->y = (Vector3f){2.0f * (xy + wz), ww - xx + yy - zz, 2.0f * (yz - wx)};
+  m->z = (Vector3f){2.0f * (xz - wy), 2.0f * (yz + wx), ww - xx - yy + zz};
+}
+/*----------------------------------------------------------------------------*/
+static void matrixGetAngles(const Matrix3x3f *m, float *angles)
+{
+  const float tmp = sqrtf(m->z.y * m->z.y + m->z.z * m->z.z);
+
+  angles[0] = atan2f(m->z.y, m->z.z);
+  angles[1] = atan2f(m->z.x, tmp);
+  angles[2] = atan2f(m->y.x, m->x.x);
+}
+/*----------------------------------------------------------------------------*/
+void dcmFilterGetAngles(const struct DcmFilter *filter, float *angles)
+{
+  matrixGetAngles(&filter->state, angles);
+}
+/*----------------------------------------------------------------------------*/
+void dcmFilterGetQuaternion(const struct DcmFilter *filter, Quaternionf *q)
+{
+  makeQuaternion(&filter->state, q);
+}
+/*----------------------------------------------------------------------------*/
+void dcmFilterInit(struct DcmFilter *filter, float dt)
+{
+  filter->accKP = 0.01f;
+  filter->magKP = 0.10f;
+  filter->velKP = 1.00f;
+  filter->dt = dt;
+
+  filter->state.x = (Vector3f){1.0f, 0.0f, 0.0f};
+  filter->state.y = (Vector3f){0.0f, 1.0f, 0.0f};
+  filter->state.z = (Vector3f){0.0f, 0.0f, 1.0f};
+
+  filter->first = true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Update the state of the filter.
+ * @param filter Pointer to a filter object.
+ * @param acc Acceleration in g or @b NULL when no new sample is available.
+ * @param mag Magnetic field or @b NULL when no new sample is available.
+ * @param vel Angular velocity in rad/s.
+ * @return @b true when the state was updated, the first update requires
+ * samples from all sensors.
+ */
+bool dcmFilterUpdate(struct DcmFilter *filter, const Vector3f *acc,
+    const Vector3f *mag, const Vector3f *vel)
+{
+  Vector3f x;
+  Vector3f y;
+  Vector3f z;
+
+  if (filter->first)
+  {
+    if (acc == NULL || mag == NULL)
+      return false;
+
+    filter->first = false;
+    makeInitialState(acc, mag, &filter->state);
+    return true;
+  }
+
+  float weight = filter->velKP;
+  Vector3f w;
+
+  vec3fMul(vel, filter->dt * filter->velKP, &w);
+
+  if (acc != NULL)
+  {
+    Vector3f va;
+
+    vec3fCrossProduct(acc, &filter->state.z, &va);
+    vec3fMul(&va, filter->accKP, &va);
+    vec3fAdd(&w, &va, &w);
+    weight += filter->accKP;
+  }
+
+  if (mag != NULL)
+  {
+    Vector3f vm;
+
+    vec3fMakeOrthogonal(&filter->state.z, mag, &vm);
+    vec3fCrossProduct(&vm, &filter->state.x, &vm);
+    vec3fMul(&vm, filter->magKP, &vm);
+    vec3fAdd(&w, &vm, &w);
+    weight += filter->magKP;
+  }
+
+  vec3fMul(&w, 1.0f / weight, &w);
+
+  /* Z axis */
+  vec3fCrossProduct(&filter->state.z, &w, &z);
+  vec3fAdd(&filter->state.z, &z, &z);
+  vec3fNormalize(&z);
+
+  /* X axis */
+  vec3fCrossProduct(&filter->state.x, &w, &x);
+  vec3fAdd(&filter->state.x, &x, &x);
+  vec3fMakeOrthogonal(&z, &x, &x);
+  vec3fNormalize(&x);
+
+  /* Y axis */
+  vec3fCrossProduct(&z, &x, &y);
+  vec3fNormalize(&y);
+
+  filter->state.x = x;
+  filter->state.y = y;
+  filter->state.z = z;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+void mahonyFilterGetAngles(const struct MahonyFilter *filter, float *angles)
+{
+  Matrix3x3f m;
+
+  makeRotationMatrix(&filter->state, &m);
+  matrixGetAngles(&m, angles);
+}
+/*----------------------------------------------------------------------------*/
+void mahonyFilterGetQuaternion(const struct MahonyFilter *filter,
+    Quaternionf *q)
+{
+  *q = filter->state;
+}
+/*----------------------------------------------------------------------------*/
+void mahonyFilterInit(struct MahonyFilter *filter, float dt)
+{
+  filter->state = (Quaternionf){1.0f, 0.0f, 0.0f, 0.0f};
+  filter->integral = (Vector3f){0.0f, 0.0f, 0.0f};
+  filter->heading = (Vector3f){1.0f, 0.0f, 0.0f};
+
+  filter->kp = 1.0f;
+  filter->ki = 0.1f;
+  filter->dt = dt;
+
+  filter->period = MAHONY_DEFAULT_PERIOD;
+  filter->iteration = 0;
+  filter->first = true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Update the state of the filter.
+ * @param filter Pointer to a filter object.
+ * @param acc Acceleration in g or @b NULL when no new sample is available.
+ * @param mag Magnetic field or @b NULL when no new sample is available.
+ * @param vel Angular velocity in rad/s.
+ * @return @b true when the state was updated, the first update requires
+ * samples from all sensors.
+ */
+bool mahonyFilterUpdate(struct MahonyFilter *filter, const Vector3f *acc,
+    const Vector3f *mag, const Vector3f *vel)
+{
+  if (filter->first)
+  {
+    Matrix3x3f initial;
+
+    if (acc == NULL || mag == NULL)
+      return false;
+
+    filter->first = false;
+    filter->heading = *mag;
+    vec3fNormalizeFast(&filter->heading);
+
+    makeInitialState(acc, mag, &initial);
+    makeQuaternion(&initial, &filter->state);
+    return true;
+  }
+
+  Vector3f error = {0.0f, 0.0f, 0.0f};
+  Matrix3x3f m;
+
+  makeRotationMatrix(&filter->state, &m);
+
+  if (acc != NULL)
+  {
+    Vector3f a = *acc;
+    Vector3f e;
+
+    /* Estimated direction of gravity is the last row of the matrix */
+    vec3fNormalizeFast(&a);
+    vec3fCrossProduct(&a, &m.z, &e);
+    vec3fAdd(&error, &e, &error);
+  }
+
+  if (mag != NULL)
+  {
+    filter->heading = *mag;
+    vec3fNormalizeFast(&filter->heading);
+  }
+
+  /* Magnetic field in the reference frame, rotated to the XZ plane */
+  Vector3f h;
+
+  mat3x3vec3fMul(&m, &filter->heading, &h);
+
+  const float bx = sqrtf(h.x * h.x + h.y * h.y);
+  const float bz = h.z;
+  const Vector3f estimated = {
+      m.x.x * bx + m.z.x * bz,
+      m.x.y * bx + m.z.y * bz,
+      m.x.z * bx + m.z.z * bz
+  };
+  Vector3f e;
+
+  vec3fCrossProduct(&filter->heading, &estimated, &e);
+  vec3fAdd(&error, &e, &error);
+
+  Vector3f omega;
+  Vector3f correction;
+
+  if (filter->ki != 0.0f)
+  {
+    vec3fMul(&error, filter->ki * filter->dt, &correction);
+    vec3fAdd(&filter->integral, &correction, &filter->integral);
+  }
+
+  vec3fMul(&error, filter->kp, &correction);
+  vec3fAdd(vel, &correction, &omega);
+  vec3fAdd(&omega, &filter->integral, &omega);
+  vec3fMul(&omega, 0.5f * filter->dt, &omega);
+
+  /* First-order integration of the quaternion derivative */
+  const Quaternionf rate = {0.0f, omega.x, omega.y, omega.z};
+  Quaternionf delta;
+
+  quatfMul(&filter->state, &rate, &delta);
+  filter->state.w += delta.w;
+  filter->state.x += delta.x;
+  filter->state.y += delta.y;
+  filter->state.z += delta.z;
+
+  if (++filter->iteration >= filter->period)
+  {
+    filter->iteration = 0;
+    quatfNormalizeFast(&filter->state);
+  }
+
+  return true;
+}
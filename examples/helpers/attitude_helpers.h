@@ -0,0 +1,59 @@
+/*
+ * helpers/attitude_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_ATTITUDE_HELPERS_H_
+#define HELPERS_ATTITUDE_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include "math_helpers.h"
+#include <stdbool.h>
+/*----------------------------------------------------------------------------*/
+struct DcmFilter
+{
+  Matrix3x3f state;
+
+  float accKP;
+  float magKP;
+  float velKP;
+  float dt;
+
+  bool first;
+};
+
+struct MahonyFilter
+{
+  Quaternionf state;
+  Vector3f integral;
+  /* Last normalized sample of the slower magnetometer */
+  Vector3f heading;
+
+  float kp;
+  float ki;
+  float dt;
+
+  /* Quaternion is renormalized once per specified number of updates */
+  unsigned int period;
+  unsigned int iteration;
+
+  bool first;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void dcmFilterGetAngles(const struct DcmFilter *, float *);
+void dcmFilterGetQuaternion(const struct DcmFilter *, Quaternionf *);
+void dcmFilterInit(struct DcmFilter *, float);
+bool dcmFilterUpdate(struct DcmFilter *, const Vector3f *, const Vector3f *,
+    const Vector3f *);
+
+void mahonyFilterGetAngles(const struct MahonyFilter *, float *);
+void mahonyFilterGetQuaternion(const struct MahonyFilter *, Quaternionf *);
+void mahonyFilterInit(struct MahonyFilter *, float);
+bool mahonyFilterUpdate(struct MahonyFilter *, const Vector3f *,
+    const Vector3f *, const Vector3f *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_ATTITUDE_HELPERS_H_ */
@@ -0,0 +1,1607 @@
+/*
+ * helpers/dfu_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "dfu_helpers.h"
+#include <halm/generic/flash.h>
+#include <halm/timer.h>
+#include <xcore/memory.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Compressed image header: magic number and size of the decoded image */
+#define DECODER_HEADER_LENGTH 8
+#define DECODER_MATCH_MIN     3
+#define DECODER_MAGIC         "DPMZ"
+
+/*
+ * Patch header: magic number, sizes and checksums of the new
+ * and the installed images
+ */
+#define PATCHER_HEADER_LENGTH 20
+#define PATCHER_MAGIC         "DPMD"
+/* Buffer on the stack for memory comparison */
+#define PATCHER_CHUNK_LENGTH  64
+/*----------------------------------------------------------------------------*/
+static uint32_t calcCrc32(uint32_t, const uint8_t *, size_t);
+static uint32_t getSectorSize(const struct FlashGeometry *, size_t, uint32_t);
+static uint32_t readWord(const uint8_t *);
+static uint32_t calcRate(const struct DfuMonitor *, unsigned long, uint32_t);
+static char *appendText(char *, const char *);
+static char *appendValue(char *, uint32_t);
+
+static bool decoderEmit(struct DfuDecoder *, uint8_t);
+static bool decoderFeed(struct DfuDecoder *, const uint8_t *, size_t);
+static bool decoderFlush(struct DfuDecoder *);
+static size_t decoderStart(struct DfuDecoder *, const uint8_t *, size_t);
+
+static enum Result decoderInit(void *, const void *);
+static void decoderDeinit(void *);
+static void decoderSetCallback(void *, void (*)(void *), void *);
+static enum Result decoderGetParam(void *, int, void *);
+static enum Result decoderSetParam(void *, int, const void *);
+static size_t decoderRead(void *, void *, size_t);
+static size_t decoderWrite(void *, const void *, size_t);
+
+static void monitorResetDownload(struct DfuMonitor *);
+
+static enum Result monitorInit(void *, const void *);
+static void monitorDeinit(void *);
+static void monitorSetCallback(void *, void (*)(void *), void *);
+static enum Result monitorGetParam(void *, int, void *);
+static enum Result monitorSetParam(void *, int, const void *);
+static size_t monitorRead(void *, void *, size_t);
+static size_t monitorWrite(void *, const void *, size_t);
+
+static bool patcherAppend(struct DfuPatcher *, const uint8_t *, size_t);
+static bool patcherCalcChecksum(struct DfuPatcher *, uint32_t, uint32_t,
+    uint32_t *);
+static bool patcherCompare(struct DfuPatcher *);
+static bool patcherCopy(struct DfuPatcher *, uint32_t, uint32_t);
+static bool patcherFeed(struct DfuPatcher *, const uint8_t *, size_t);
+static bool patcherFlush(struct DfuPatcher *);
+static void patcherResume(struct DfuPatcher *);
+static size_t patcherStart(struct DfuPatcher *, const uint8_t *, size_t);
+
+static enum Result patcherInit(void *, const void *);
+static void patcherDeinit(void *);
+static void patcherSetCallback(void *, void (*)(void *), void *);
+static enum Result patcherGetParam(void *, int, void *);
+static enum Result patcherSetParam(void *, int, const void *);
+static size_t patcherRead(void *, void *, size_t);
+static size_t patcherWrite(void *, const void *, size_t);
+
+static enum Result pipelineErase(struct DfuPipeline *, int, uint32_t);
+static bool pipelineEraseAhead(struct DfuPipeline *);
+static enum Result pipelineResume(struct DfuPipeline *);
+static enum Result pipelineSuspend(struct DfuPipeline *);
+static enum Result pipelineWait(struct DfuPipeline *);
+static void onPipelineEvent(void *);
+
+static enum Result pipelineInit(void *, const void *);
+static void pipelineDeinit(void *);
+static void pipelineSetCallback(void *, void (*)(void *), void *);
+static enum Result pipelineGetParam(void *, int, void *);
+static enum Result pipelineSetParam(void *, int, const void *);
+static size_t pipelineRead(void *, void *, size_t);
+static size_t pipelineWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const DfuDecoder = &(const struct InterfaceClass){
+    .size = sizeof(struct DfuDecoder),
+    .init = decoderInit,
+    .deinit = decoderDeinit,
+
+    .setCallback = decoderSetCallback,
+    .getParam = decoderGetParam,
+    .setParam = decoderSetParam,
+    .read = decoderRead,
+    .write = decoderWrite
+};
+
+const struct InterfaceClass * const DfuMonitor = &(const struct InterfaceClass){
+    .size = sizeof(struct DfuMonitor),
+    .init = monitorInit,
+    .deinit = monitorDeinit,
+
+    .setCallback = monitorSetCallback,
+    .getParam = monitorGetParam,
+    .setParam = monitorSetParam,
+    .read = monitorRead,
+    .write = monitorWrite
+};
+
+const struct InterfaceClass * const DfuPatcher = &(const struct InterfaceClass){
+    .size = sizeof(struct DfuPatcher),
+    .init = patcherInit,
+    .deinit = patcherDeinit,
+
+    .setCallback = patcherSetCallback,
+    .getParam = patcherGetParam,
+    .setParam = patcherSetParam,
+    .read = patcherRead,
+    .write = patcherWrite
+};
+
+const struct InterfaceClass * const DfuPipeline =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct DfuPipeline),
+    .init = pipelineInit,
+    .deinit = pipelineDeinit,
+
+    .setCallback = pipelineSetCallback,
+    .getParam = pipelineGetParam,
+    .setParam = pipelineSetParam,
+    .read = pipelineRead,
+    .write = pipelineWrite
+};
+/*----------------------------------------------------------------------------*/
+/* CRC-32, reflected polynomial 0xEDB88320, compatible with zlib */
+static uint32_t calcCrc32(uint32_t crc, const uint8_t *buffer, size_t length)
+{
+  static const uint32_t crcTable[16] = {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+      0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+      0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+      0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+
+  while (length--)
+  {
+    crc = (crc >> 4) ^ crcTable[(crc ^ *buffer) & 0x0F];
+    crc = (crc >> 4) ^ crcTable[(crc ^ (*buffer >> 4)) & 0x0F];
+    ++buffer;
+  }
+
+  return crc;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t getSectorSize(const struct FlashGeometry *geometry,
+    size_t regions, uint32_t position)
+{
+  uint32_t address = 0;
+
+  for (size_t i = 0; i < regions; ++i)
+  {
+    const uint32_t length = geometry[i].count * geometry[i].size;
+
+    if (position >= address && position < address + length)
+      return geometry[i].size;
+    address += length;
+  }
+
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t readWord(const uint8_t *buffer)
+{
+  return buffer[0] | buffer[1] << 8 | buffer[2] << 16
+      | (uint32_t)buffer[3] << 24;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t calcRate(const struct DfuMonitor *monitor, unsigned long bytes,
+    uint32_t ticks)
+{
+  if (!ticks)
+    return 0;
+
+  const uint64_t frequency = timerGetFrequency(monitor->timer);
+  return (uint32_t)((uint64_t)bytes * frequency / ticks);
+}
+/*----------------------------------------------------------------------------*/
+static char *appendText(char *buffer, const char *text)
+{
+  const size_t length = strlen(text);
+
+  memcpy(buffer, text, length);
+  return buffer + length;
+}
+/*----------------------------------------------------------------------------*/
+static char *appendValue(char *buffer, uint32_t value)
+{
+  /* Values are zero-padded to keep the length of the report constant */
+  for (size_t i = 10; i; --i)
+  {
+    buffer[i - 1] = (char)('0' + value % 10);
+    value /= 10;
+  }
+
+  return buffer + 10;
+}
+/*----------------------------------------------------------------------------*/
+static bool decoderEmit(struct DfuDecoder *decoder, uint8_t value)
+{
+  decoder->window[decoder->head] = value;
+  decoder->head = (decoder->head + 1) & (DFU_DECODER_WINDOW - 1);
+  decoder->buffer[decoder->fill++] = value;
+  ++decoder->decoded;
+
+  if (decoder->fill == decoder->size || decoder->decoded == decoder->length)
+    return decoderFlush(decoder);
+  else
+    return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool decoderFeed(struct DfuDecoder *decoder, const uint8_t *input,
+    size_t length)
+{
+  for (size_t i = 0; i < length; ++i)
+  {
+    const uint8_t value = input[i];
+
+    switch (decoder->state)
+    {
+      case DFU_DECODER_CONTROL:
+        decoder->control = value;
+        decoder->items = 8;
+        decoder->state = DFU_DECODER_ITEM;
+        continue;
+
+      case DFU_DECODER_ITEM:
+        if (!(decoder->control & 1))
+        {
+          decoder->match = value;
+          decoder->state = DFU_DECODER_MATCH;
+          continue;
+        }
+
+        if (!decoderEmit(decoder, value))
+          return false;
+        break;
+
+      case DFU_DECODER_MATCH:
+      {
+        /* Reference: 12-bit distance and 4-bit length */
+        const uint16_t distance = (decoder->match | (value & 0xF0) << 4) + 1;
+        const uint32_t count = MIN((uint32_t)(value & 0x0F) + DECODER_MATCH_MIN,
+            decoder->length - decoder->decoded);
+
+        if (distance > decoder->decoded)
+          return false;
+
+        for (uint32_t j = 0; j < count; ++j)
+        {
+          const uint16_t index =
+              (decoder->head - distance) & (DFU_DECODER_WINDOW - 1);
+
+          if (!decoderEmit(decoder, decoder->window[index]))
+            return false;
+        }
+        break;
+      }
+
+      default:
+        /* Padding after the end of the image is ignored */
+        return true;
+    }
+
+    if (decoder->decoded == decoder->length)
+    {
+      decoder->state = DFU_DECODER_DONE;
+      return true;
+    }
+
+    decoder->control >>= 1;
+    decoder->state = --decoder->items ?
+        DFU_DECODER_ITEM : DFU_DECODER_CONTROL;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool decoderFlush(struct DfuDecoder *decoder)
+{
+  const uint32_t fill = (uint32_t)decoder->fill;
+  const uint32_t position = decoder->offset + decoder->decoded - fill;
+
+  /* Bridge erases sectors of the compressed stream, decoded data is larger */
+  while (decoder->erased < position + fill)
+  {
+    uint32_t address = decoder->erased;
+    const uint32_t sector = getSectorSize(decoder->geometry, decoder->regions,
+        address);
+
+    if (!sector)
+      return false;
+    if (ifSetParam(decoder->flash, IF_FLASH_ERASE_SECTOR, &address) != E_OK)
+      return false;
+
+    decoder->erased += sector;
+  }
+
+  if (ifSetParam(decoder->flash, IF_POSITION, &position) != E_OK)
+    return false;
+  if (ifWrite(decoder->flash, decoder->buffer, fill) != fill)
+    return false;
+
+  decoder->fill = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t decoderStart(struct DfuDecoder *decoder, const uint8_t *input,
+    size_t length)
+{
+  if (length < DECODER_HEADER_LENGTH
+      || memcmp(input, DECODER_MAGIC, strlen(DECODER_MAGIC)))
+  {
+    /* Image without the header is written as is */
+    decoder->state = DFU_DECODER_RAW;
+    return 0;
+  }
+
+  decoder->length = readWord(input + 4);
+  decoder->decoded = 0;
+  decoder->fill = 0;
+  decoder->head = 0;
+  decoder->state = decoder->length ? DFU_DECODER_CONTROL : DFU_DECODER_DONE;
+
+  if (decoder->erased < decoder->offset)
+    decoder->erased = decoder->offset;
+
+  return DECODER_HEADER_LENGTH;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result decoderInit(void *object, const void *configBase)
+{
+  const struct DfuDecoderConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->flash != NULL && config->geometry != NULL);
+  assert(config->regions > 0 && config->size > 0);
+
+  struct DfuDecoder * const decoder = object;
+
+  decoder->window = malloc(DFU_DECODER_WINDOW);
+  if (decoder->window == NULL)
+    return E_MEMORY;
+
+  decoder->buffer = malloc(config->size);
+  if (decoder->buffer == NULL)
+  {
+    free(decoder->window);
+    return E_MEMORY;
+  }
+
+  decoder->flash = config->flash;
+  decoder->geometry = config->geometry;
+  decoder->regions = config->regions;
+  decoder->size = config->size;
+  decoder->fill = 0;
+
+  decoder->offset = (uint32_t)config->offset;
+  decoder->position = 0;
+  decoder->erased = 0;
+  decoder->length = 0;
+  decoder->decoded = 0;
+  decoder->head = 0;
+
+  decoder->control = 0;
+  decoder->items = 0;
+  decoder->match = 0;
+  decoder->state = DFU_DECODER_RAW;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void decoderDeinit(void *object)
+{
+  struct DfuDecoder * const decoder = object;
+
+  free(decoder->buffer);
+  free(decoder->window);
+}
+/*----------------------------------------------------------------------------*/
+static void decoderSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct DfuDecoder * const decoder = object;
+  ifSetCallback(decoder->flash, callback, argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result decoderGetParam(void *object, int parameter, void *data)
+{
+  struct DfuDecoder * const decoder = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = decoder->position;
+      return E_OK;
+
+    case IF_STATUS:
+      if (decoder->state == DFU_DECODER_RAW
+          || decoder->state == DFU_DECODER_DONE)
+      {
+        return ifGetParam(decoder->flash, parameter, data);
+      }
+
+      /* Stream ended before the whole image was decoded */
+      if (decoder->state != DFU_DECODER_ERROR && decoder->fill)
+        decoderFlush(decoder);
+      return E_ERROR;
+
+    default:
+      return ifGetParam(decoder->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result decoderSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct DfuDecoder * const decoder = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    case IF_FLASH_ERASE_PAGE:
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const uint32_t position = *(const uint32_t *)data;
+
+      /* Erasing of the first sector starts a new download */
+      if (position == decoder->offset)
+      {
+        decoder->state = DFU_DECODER_RAW;
+        decoder->erased = 0;
+      }
+      else if (decoder->state != DFU_DECODER_RAW)
+      {
+        /* Decoder erases sectors for the decoded data itself */
+        return E_OK;
+      }
+
+      const enum Result res = ifSetParam(decoder->flash, parameter, data);
+
+      if (res == E_OK && position == decoder->offset
+          && parameter == IF_FLASH_ERASE_SECTOR)
+      {
+        decoder->erased = position + getSectorSize(decoder->geometry,
+            decoder->regions, position);
+      }
+      return res;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      decoder->position = *(const uint32_t *)data;
+      return E_OK;
+
+    default:
+      return ifSetParam(decoder->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t decoderRead(void *object, void *buffer, size_t length)
+{
+  struct DfuDecoder * const decoder = object;
+
+  if (ifSetParam(decoder->flash, IF_POSITION, &decoder->position) != E_OK)
+    return 0;
+
+  const size_t count = ifRead(decoder->flash, buffer, length);
+
+  decoder->position += (uint32_t)count;
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t decoderWrite(void *object, const void *buffer, size_t length)
+{
+  struct DfuDecoder * const decoder = object;
+  const uint8_t * const input = buffer;
+  size_t skip = 0;
+
+  if (decoder->position == decoder->offset)
+    skip = decoderStart(decoder, input, length);
+
+  if (decoder->state == DFU_DECODER_RAW)
+  {
+    if (ifSetParam(decoder->flash, IF_POSITION, &decoder->position) != E_OK)
+      return 0;
+
+    const size_t count = ifWrite(decoder->flash, buffer, length);
+
+    decoder->position += (uint32_t)count;
+    return count;
+  }
+
+  if (!decoderFeed(decoder, input + skip, length - skip))
+    decoder->state = DFU_DECODER_ERROR;
+  if (decoder->state == DFU_DECODER_ERROR)
+    return 0;
+
+  decoder->position += (uint32_t)length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static void monitorResetDownload(struct DfuMonitor *monitor)
+{
+  monitor->downloadStart = 0;
+  monitor->downloadEnd = 0;
+  monitor->downloaded = 0;
+  monitor->erased = 0;
+  monitor->eraseTime = 0;
+  monitor->eraseMax = 0;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result monitorInit(void *object, const void *configBase)
+{
+  const struct DfuMonitorConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->flash != NULL && config->timer != NULL);
+
+  struct DfuMonitor * const monitor = object;
+
+  monitor->flash = config->flash;
+  monitor->timer = config->timer;
+  monitor->offset = (uint32_t)config->offset;
+  monitor->position = 0;
+
+  monitorResetDownload(monitor);
+  monitor->uploadStart = 0;
+  monitor->uploadEnd = 0;
+  monitor->uploaded = 0;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void monitorDeinit(void *)
+{
+  /* Underlying memory interface is owned by the caller */
+}
+/*----------------------------------------------------------------------------*/
+static void monitorSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct DfuMonitor * const monitor = object;
+  ifSetCallback(monitor->flash, callback, argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result monitorGetParam(void *object, int parameter, void *data)
+{
+  struct DfuMonitor * const monitor = object;
+  return ifGetParam(monitor->flash, parameter, data);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result monitorSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct DfuMonitor * const monitor = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    case IF_FLASH_ERASE_PAGE:
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      /* Erasing the start of the image begins a new download */
+      if (*(const uint32_t *)data == monitor->offset)
+        monitorResetDownload(monitor);
+
+      const uint32_t start = timerGetValue(monitor->timer);
+      const enum Result res = ifSetParam(monitor->flash, parameter, data);
+      const uint32_t ticks = timerGetValue(monitor->timer) - start;
+
+      if (res == E_OK)
+      {
+        ++monitor->erased;
+        monitor->eraseTime += ticks;
+        monitor->eraseMax = MAX(monitor->eraseMax, ticks);
+      }
+      return res;
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+    {
+      const enum Result res = ifSetParam(monitor->flash, parameter, data);
+
+      if (res == E_OK)
+        monitor->position = *(const uint32_t *)data;
+      return res;
+    }
+
+    default:
+      return ifSetParam(monitor->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t monitorRead(void *object, void *buffer, size_t length)
+{
+  struct DfuMonitor * const monitor = object;
+  const uint32_t start = timerGetValue(monitor->timer);
+  const size_t count = ifRead(monitor->flash, buffer, length);
+
+  /* Reading the start of the image begins a new upload */
+  if (monitor->position == monitor->offset || !monitor->uploaded)
+  {
+    monitor->uploadStart = start;
+    monitor->uploaded = 0;
+  }
+  monitor->uploadEnd = timerGetValue(monitor->timer);
+  monitor->uploaded += count;
+  monitor->position += (uint32_t)count;
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t monitorWrite(void *object, const void *buffer, size_t length)
+{
+  struct DfuMonitor * const monitor = object;
+  const uint32_t start = timerGetValue(monitor->timer);
+  const size_t count = ifWrite(monitor->flash, buffer, length);
+
+  /* Download without a preceding erase starts with a write to the image */
+  if (monitor->position == monitor->offset || !monitor->downloaded)
+  {
+    monitor->downloadStart = start;
+    monitor->downloaded = 0;
+  }
+  monitor->downloadEnd = timerGetValue(monitor->timer);
+  monitor->downloaded += count;
+  monitor->position += (uint32_t)count;
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static bool patcherAppend(struct DfuPatcher *patcher, const uint8_t *input,
+    size_t length)
+{
+  while (length)
+  {
+    const size_t chunk = MIN(length, patcher->sectorSize - patcher->fill);
+
+    memcpy(patcher->buffer + patcher->fill, input, chunk);
+    patcher->fill += chunk;
+    patcher->produced += (uint32_t)chunk;
+    input += chunk;
+    length -= chunk;
+
+    if (patcher->fill == patcher->sectorSize
+        || patcher->produced == patcher->length)
+    {
+      if (!patcherFlush(patcher))
+        return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/* Sector buffer is used as a scratch area, it should be empty */
+static bool patcherCalcChecksum(struct DfuPatcher *patcher, uint32_t position,
+    uint32_t length, uint32_t *checksum)
+{
+  uint32_t crc = 0xFFFFFFFFUL;
+
+  while (length)
+  {
+    const size_t chunk = MIN(length, patcher->size);
+
+    if (ifSetParam(patcher->flash, IF_POSITION, &position) != E_OK)
+      return false;
+    if (ifRead(patcher->flash, patcher->buffer, chunk) != chunk)
+      return false;
+
+    crc = calcCrc32(crc, patcher->buffer, chunk);
+    position += (uint32_t)chunk;
+    length -= (uint32_t)chunk;
+  }
+
+  *checksum = ~crc;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool patcherCompare(struct DfuPatcher *patcher)
+{
+  uint8_t chunk[PATCHER_CHUNK_LENGTH];
+
+  for (size_t i = 0; i < patcher->fill; i += sizeof(chunk))
+  {
+    const size_t length = MIN(sizeof(chunk), patcher->fill - i);
+    const uint32_t position = patcher->sector + (uint32_t)i;
+
+    if (ifSetParam(patcher->flash, IF_POSITION, &position) != E_OK)
+      return false;
+    if (ifRead(patcher->flash, chunk, length) != length)
+      return false;
+    if (memcmp(chunk, patcher->buffer + i, length))
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool patcherCopy(struct DfuPatcher *patcher, uint32_t source,
+    uint32_t length)
+{
+  if (source > patcher->sourceLength
+      || length > patcher->sourceLength - source)
+  {
+    return false;
+  }
+
+  /*
+   * Data is read from the installed image. Sectors rewritten before
+   * the current one are not referenced, it is checked by the packer.
+   */
+  while (length)
+  {
+    const size_t chunk = MIN(length, patcher->sectorSize - patcher->fill);
+    const uint32_t position = patcher->offset + source;
+
+    if (ifSetParam(patcher->flash, IF_POSITION, &position) != E_OK)
+      return false;
+    if (ifRead(patcher->flash, patcher->buffer + patcher->fill, chunk)
+        != chunk)
+    {
+      return false;
+    }
+
+    patcher->fill += chunk;
+    patcher->produced += (uint32_t)chunk;
+    source += (uint32_t)chunk;
+    length -= (uint32_t)chunk;
+
+    if (patcher->fill == patcher->sectorSize
+        || patcher->produced == patcher->length)
+    {
+      if (!patcherFlush(patcher))
+        return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool patcherFeed(struct DfuPatcher *patcher, const uint8_t *input,
+    size_t length)
+{
+  size_t index = 0;
+
+  while (index < length)
+  {
+    switch (patcher->state)
+    {
+      case DFU_PATCHER_COMMAND:
+      case DFU_PATCHER_SOURCE:
+      {
+        /* Arguments are encoded as unsigned LEB128 numbers */
+        const uint8_t value = input[index++];
+
+        if (patcher->shift > 28)
+          return false;
+
+        patcher->argument |= (uint32_t)(value & 0x7F) << patcher->shift;
+        patcher->shift += 7;
+
+        if (value & 0x80)
+          continue;
+
+        const uint32_t argument = patcher->argument;
+
+        patcher->argument = 0;
+        patcher->shift = 0;
+
+        if (patcher->state == DFU_PATCHER_COMMAND)
+        {
+          /* Lowest bit selects between insertion and copying */
+          patcher->count = argument >> 1;
+
+          if (!patcher->count
+              || patcher->count > patcher->length - patcher->produced)
+          {
+            return false;
+          }
+
+          patcher->state = (argument & 1) ?
+              DFU_PATCHER_INSERT : DFU_PATCHER_SOURCE;
+        }
+        else
+        {
+          if (!patcherCopy(patcher, argument, patcher->count))
+            return false;
+          patcher->state = DFU_PATCHER_COMMAND;
+        }
+        break;
+      }
+
+      case DFU_PATCHER_INSERT:
+      {
+        const size_t chunk = MIN(patcher->count, length - index);
+
+        if (!patcherAppend(patcher, input + index, chunk))
+          return false;
+
+        index += chunk;
+        patcher->count -= (uint32_t)chunk;
+
+        if (!patcher->count)
+          patcher->state = DFU_PATCHER_COMMAND;
+        break;
+      }
+
+      default:
+        /* Padding after the end of the patch is ignored */
+        return true;
+    }
+
+    if (patcher->produced == patcher->length)
+    {
+      uint32_t checksum;
+
+      if (!patcherCalcChecksum(patcher, patcher->offset, patcher->length,
+          &checksum) || checksum != patcher->checksum)
+      {
+        return false;
+      }
+
+      patcher->state = DFU_PATCHER_DONE;
+      return true;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool patcherFlush(struct DfuPatcher *patcher)
+{
+  /* Unchanged sectors are neither erased nor programmed */
+  if (patcherCompare(patcher))
+  {
+    ++patcher->skipped;
+  }
+  else
+  {
+    uint32_t position = patcher->sector;
+
+    if (ifSetParam(patcher->flash, IF_FLASH_ERASE_SECTOR, &position) != E_OK)
+      return false;
+
+    for (size_t i = 0; i < patcher->fill;)
+    {
+      position = patcher->sector + (uint32_t)i;
+
+      if (ifSetParam(patcher->flash, IF_POSITION, &position) != E_OK)
+        return false;
+
+      const size_t count = ifWrite(patcher->flash, patcher->buffer + i,
+          patcher->fill - i);
+
+      if (!count)
+        return false;
+      i += count;
+    }
+
+    ++patcher->rewritten;
+  }
+
+  patcher->sector += patcher->sectorSize;
+  patcher->fill = 0;
+
+  if (patcher->produced < patcher->length)
+  {
+    patcher->sectorSize = getSectorSize(patcher->geometry, patcher->regions,
+        patcher->sector);
+
+    if (!patcher->sectorSize || patcher->sectorSize > patcher->size)
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void patcherResume(struct DfuPatcher *patcher)
+{
+  if (patcher->suspended)
+  {
+    ifSetParam(patcher->flash, IF_ZEROCOPY, NULL);
+    patcher->suspended = false;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t patcherStart(struct DfuPatcher *patcher, const uint8_t *input,
+    size_t length)
+{
+  if (length < PATCHER_HEADER_LENGTH
+      || memcmp(input, PATCHER_MAGIC, strlen(PATCHER_MAGIC)))
+  {
+    /* Full image is written as is */
+    patcher->state = DFU_PATCHER_RAW;
+    return 0;
+  }
+
+  patcher->length = readWord(input + 4);
+  patcher->sourceLength = readWord(input + 8);
+  patcher->sourceChecksum = readWord(input + 12);
+  patcher->checksum = readWord(input + 16);
+  patcher->state = DFU_PATCHER_ERROR;
+
+  /* Installed image should be the one the patch was made for */
+  uint32_t checksum;
+
+  if (!patcherCalcChecksum(patcher, patcher->offset, patcher->sourceLength,
+      &checksum) || checksum != patcher->sourceChecksum)
+  {
+    return 0;
+  }
+
+  patcher->sector = patcher->offset;
+  patcher->sectorSize = getSectorSize(patcher->geometry, patcher->regions,
+      patcher->sector);
+
+  if (!patcher->length || !patcher->sectorSize
+      || patcher->sectorSize > patcher->size)
+  {
+    return 0;
+  }
+
+  /* Background erasing would destroy sectors of the installed image */
+  ifSetParam(patcher->flash, IF_BLOCKING, NULL);
+  patcher->suspended = true;
+
+  patcher->deferred = 0;
+  patcher->fill = 0;
+  patcher->produced = 0;
+  patcher->argument = 0;
+  patcher->count = 0;
+  patcher->shift = 0;
+  patcher->rewritten = 0;
+  patcher->skipped = 0;
+  patcher->state = DFU_PATCHER_COMMAND;
+
+  return PATCHER_HEADER_LENGTH;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result patcherInit(void *object, const void *configBase)
+{
+  const struct DfuPatcherConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->flash != NULL && config->geometry != NULL);
+  assert(config->regions > 0 && config->size > 0);
+
+  struct DfuPatcher * const patcher = object;
+
+  patcher->buffer = malloc(config->size);
+  if (patcher->buffer == NULL)
+    return E_MEMORY;
+
+  patcher->flash = config->flash;
+  patcher->geometry = config->geometry;
+  patcher->regions = config->regions;
+  patcher->size = config->size;
+  patcher->fill = 0;
+
+  patcher->offset = (uint32_t)config->offset;
+  patcher->position = 0;
+  patcher->sector = 0;
+  patcher->sectorSize = 0;
+
+  patcher->sourceLength = 0;
+  patcher->sourceChecksum = 0;
+  patcher->length = 0;
+  patcher->checksum = 0;
+  patcher->produced = 0;
+
+  patcher->argument = 0;
+  patcher->count = 0;
+  patcher->shift = 0;
+
+  patcher->rewritten = 0;
+  patcher->skipped = 0;
+
+  patcher->deferred = 0;
+  patcher->state = DFU_PATCHER_RAW;
+  patcher->suspended = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void patcherDeinit(void *object)
+{
+  struct DfuPatcher * const patcher = object;
+  free(patcher->buffer);
+}
+/*----------------------------------------------------------------------------*/
+static void patcherSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct DfuPatcher * const patcher = object;
+  ifSetCallback(patcher->flash, callback, argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result patcherGetParam(void *object, int parameter, void *data)
+{
+  struct DfuPatcher * const patcher = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = patcher->position;
+      return E_OK;
+
+    case IF_STATUS:
+      /* Image is not valid until the whole patch is applied and verified */
+      if (patcher->state != DFU_PATCHER_RAW
+          && patcher->state != DFU_PATCHER_DONE)
+      {
+        return E_ERROR;
+      }
+      return ifGetParam(patcher->flash, parameter, data);
+
+    default:
+      return ifGetParam(patcher->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result patcherSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct DfuPatcher * const patcher = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    case IF_FLASH_ERASE_PAGE:
+    case IF_FLASH_ERASE_SECTOR:
+      if (*(const uint32_t *)data == patcher->offset)
+      {
+        /* First sector is still needed when the download is a patch */
+        patcherResume(patcher);
+        patcher->deferred = parameter;
+        patcher->state = DFU_PATCHER_RAW;
+        return E_OK;
+      }
+      else if (patcher->state != DFU_PATCHER_RAW)
+      {
+        /* Patcher erases changed sectors itself */
+        return E_OK;
+      }
+      else
+        return ifSetParam(patcher->flash, parameter, data);
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      patcher->position = *(const uint32_t *)data;
+      return E_OK;
+
+    default:
+      return ifSetParam(patcher->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t patcherRead(void *object, void *buffer, size_t length)
+{
+  struct DfuPatcher * const patcher = object;
+
+  if (ifSetParam(patcher->flash, IF_POSITION, &patcher->position) != E_OK)
+    return 0;
+
+  const size_t count = ifRead(patcher->flash, buffer, length);
+
+  patcher->position += (uint32_t)count;
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t patcherWrite(void *object, const void *buffer, size_t length)
+{
+  struct DfuPatcher * const patcher = object;
+  const uint8_t * const input = buffer;
+  size_t skip = 0;
+
+  if (patcher->position == patcher->offset)
+    skip = patcherStart(patcher, input, length);
+
+  if (patcher->state == DFU_PATCHER_RAW)
+  {
+    if (patcher->deferred)
+    {
+      const int parameter = patcher->deferred;
+
+      patcher->deferred = 0;
+      if (ifSetParam(patcher->flash, parameter, &patcher->offset) != E_OK)
+        return 0;
+    }
+
+    if (ifSetParam(patcher->flash, IF_POSITION, &patcher->position) != E_OK)
+      return 0;
+
+    const size_t count = ifWrite(patcher->flash, buffer, length);
+
+    patcher->position += (uint32_t)count;
+    return count;
+  }
+
+  if (patcher->state == DFU_PATCHER_ERROR)
+    return 0;
+
+  const bool accepted = patcherFeed(patcher, input + skip, length - skip);
+
+  if (!accepted)
+    patcher->state = DFU_PATCHER_ERROR;
+
+  /* Background operations are resumed when the patch is finished */
+  if (patcher->state == DFU_PATCHER_DONE
+      || patcher->state == DFU_PATCHER_ERROR)
+  {
+    patcherResume(patcher);
+  }
+
+  if (!accepted)
+    return 0;
+
+  patcher->position += (uint32_t)length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/* Erase request from the bridge, the memory should be idle */
+static enum Result pipelineErase(struct DfuPipeline *pipeline, int parameter,
+    uint32_t position)
+{
+  uint32_t size;
+
+  if (parameter == IF_FLASH_ERASE_BLOCK)
+    size = pipeline->block;
+  else if (parameter == IF_FLASH_ERASE_SECTOR)
+    size = getSectorSize(pipeline->geometry, pipeline->regions, position);
+  else
+    size = 0;
+
+  /* Area was erased in the background and nothing was programmed there */
+  if (size && position >= pipeline->erasedBase
+      && position >= pipeline->programmed
+      && position + size <= pipeline->erasedEnd)
+  {
+    ++pipeline->skipped;
+    return E_OK;
+  }
+
+  pipeline->state = DFU_PIPELINE_ERASE;
+
+  enum Result res = ifSetParam(pipeline->flash, parameter, &position);
+
+  if (res == E_BUSY)
+    res = pipelineWait(pipeline);
+  else
+    pipeline->state = DFU_PIPELINE_IDLE;
+
+  if (res == E_OK)
+    ++pipeline->erased;
+
+  if (res == E_OK && size)
+  {
+    pipeline->erasedBase = position;
+    pipeline->erasedEnd = position + size;
+    pipeline->programmed = position;
+    pipeline->pending = pipeline->erasedEnd;
+  }
+  else
+  {
+    pipeline->erasedBase = 0;
+    pipeline->erasedEnd = 0;
+    pipeline->programmed = 0;
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+/* Start erasing the next unit ahead of the write pointer */
+static bool pipelineEraseAhead(struct DfuPipeline *pipeline)
+{
+  const uint32_t position = pipeline->erasedEnd;
+
+  if (position == pipeline->erasedBase || pipeline->status != E_OK)
+    return false;
+  if (position - pipeline->programmed >= pipeline->ahead)
+    return false;
+
+  const uint32_t sector = getSectorSize(pipeline->geometry, pipeline->regions,
+      position);
+  uint32_t size;
+  int parameter;
+
+  if (!sector)
+    return false;
+
+  /* Whole blocks are erased faster than the same area sector by sector */
+  if (pipeline->block > sector && !(position % pipeline->block)
+      && position + pipeline->block <= pipeline->capacity)
+  {
+    parameter = IF_FLASH_ERASE_BLOCK;
+    size = pipeline->block;
+  }
+  else
+  {
+    parameter = IF_FLASH_ERASE_SECTOR;
+    size = sector;
+  }
+
+  pipeline->pending = position + size;
+  pipeline->state = DFU_PIPELINE_ERASE_AHEAD;
+
+  const enum Result res = ifSetParam(pipeline->flash, parameter, &position);
+
+  if (res == E_BUSY)
+    return true;
+
+  /* Otherwise the area will be erased on request of the bridge */
+  if (res == E_OK)
+    pipeline->erasedEnd = pipeline->pending;
+  return false;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineResume(struct DfuPipeline *pipeline)
+{
+  const enum Result res = ifSetParam(pipeline->flash, IF_ZEROCOPY, NULL);
+
+  if (res == E_OK)
+  {
+    pipeline->erasedBase = 0;
+    pipeline->erasedEnd = 0;
+    pipeline->programmed = 0;
+    pipeline->status = E_OK;
+    pipeline->state = DFU_PIPELINE_IDLE;
+    pipeline->zerocopy = true;
+
+    ifSetCallback(pipeline->flash, onPipelineEvent, pipeline);
+  }
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineSuspend(struct DfuPipeline *pipeline)
+{
+  /* New operations are started only from the callback of the previous one */
+  const enum Result res = pipelineWait(pipeline);
+
+  ifSetCallback(pipeline->flash, NULL, NULL);
+  ifSetParam(pipeline->flash, IF_BLOCKING, NULL);
+  pipeline->zerocopy = false;
+
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineWait(struct DfuPipeline *pipeline)
+{
+  while (pipeline->state != DFU_PIPELINE_IDLE)
+    barrier();
+
+  /* Report the error of the background operation only once */
+  const enum Result res = pipeline->status;
+
+  pipeline->status = E_OK;
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static void onPipelineEvent(void *argument)
+{
+  struct DfuPipeline * const pipeline = argument;
+  const enum Result res = ifGetParam(pipeline->flash, IF_STATUS, NULL);
+
+  if (pipeline->state == DFU_PIPELINE_ERASE_AHEAD)
+  {
+    /* Failed area will be erased again on request of the bridge */
+    if (res == E_OK)
+      pipeline->erasedEnd = pipeline->pending;
+  }
+  else if (res != E_OK)
+  {
+    pipeline->status = res;
+  }
+
+  /* Erase runs while the next block is received by the USB device */
+  if (!pipelineEraseAhead(pipeline))
+    pipeline->state = DFU_PIPELINE_IDLE;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineInit(void *object, const void *configBase)
+{
+  const struct DfuPipelineConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->flash != NULL && config->geometry != NULL);
+  assert(config->regions > 0 && config->size > 0);
+
+  struct DfuPipeline * const pipeline = object;
+
+  pipeline->buffer = malloc(config->size);
+  if (pipeline->buffer == NULL)
+    return E_MEMORY;
+
+  pipeline->flash = config->flash;
+  pipeline->geometry = config->geometry;
+  pipeline->regions = config->regions;
+  pipeline->size = config->size;
+  pipeline->ahead = config->ahead;
+
+  if (ifGetParam(pipeline->flash, IF_SIZE, &pipeline->capacity) != E_OK)
+    pipeline->capacity = 0;
+  if (ifGetParam(pipeline->flash, IF_FLASH_BLOCK_SIZE, &pipeline->block)
+      != E_OK)
+  {
+    pipeline->block = 0;
+  }
+
+  pipeline->erasedBase = 0;
+  pipeline->erasedEnd = 0;
+  pipeline->programmed = 0;
+  pipeline->pending = 0;
+  pipeline->position = 0;
+
+  pipeline->erased = 0;
+  pipeline->skipped = 0;
+
+  pipeline->status = E_OK;
+  pipeline->state = DFU_PIPELINE_IDLE;
+
+  /* Memories without zero-copy mode are accessed directly */
+  pipeline->zerocopy = false;
+  pipelineResume(pipeline);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void pipelineDeinit(void *object)
+{
+  struct DfuPipeline * const pipeline = object;
+
+  if (pipeline->zerocopy)
+  {
+    /* Disable background erasing and wait for the last operation */
+    pipeline->status = E_ERROR;
+    pipelineSuspend(pipeline);
+  }
+
+  free(pipeline->buffer);
+}
+/*----------------------------------------------------------------------------*/
+static void pipelineSetCallback(void *, void (*)(void *), void *)
+{
+  /* Requests of the bridge are completed in blocking mode */
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineGetParam(void *object, int parameter, void *data)
+{
+  struct DfuPipeline * const pipeline = object;
+
+  if (!pipeline->zerocopy)
+    return ifGetParam(pipeline->flash, parameter, data);
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = pipeline->position;
+      return E_OK;
+
+    case IF_STATUS:
+      return pipelineWait(pipeline);
+
+    default:
+      pipelineWait(pipeline);
+      return ifGetParam(pipeline->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct DfuPipeline * const pipeline = object;
+
+  /* Blocking mode suspends background operations */
+  if (parameter == IF_BLOCKING)
+    return pipeline->zerocopy ? pipelineSuspend(pipeline) : E_OK;
+  if (parameter == IF_ZEROCOPY)
+    return pipeline->zerocopy ? E_OK : pipelineResume(pipeline);
+
+  if (!pipeline->zerocopy)
+    return ifSetParam(pipeline->flash, parameter, data);
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+    case IF_FLASH_ERASE_PAGE:
+    case IF_FLASH_ERASE_SECTOR:
+    {
+      const enum Result res = pipelineWait(pipeline);
+
+      if (res != E_OK)
+        return res;
+
+      return pipelineErase(pipeline, parameter, *(const uint32_t *)data);
+    }
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      if (pipeline->capacity && *(const uint32_t *)data >= pipeline->capacity)
+        return E_ADDRESS;
+
+      pipeline->position = *(const uint32_t *)data;
+      return E_OK;
+
+    default:
+      pipelineWait(pipeline);
+      return ifSetParam(pipeline->flash, parameter, data);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t pipelineRead(void *object, void *buffer, size_t length)
+{
+  struct DfuPipeline * const pipeline = object;
+
+  if (!pipeline->zerocopy)
+    return ifRead(pipeline->flash, buffer, length);
+
+  if (pipelineWait(pipeline) != E_OK)
+    return 0;
+  if (ifSetParam(pipeline->flash, IF_POSITION, &pipeline->position) != E_OK)
+    return 0;
+
+  pipeline->state = DFU_PIPELINE_READ;
+
+  const size_t count = ifRead(pipeline->flash, buffer, length);
+
+  if (!count)
+  {
+    pipeline->state = DFU_PIPELINE_IDLE;
+    return 0;
+  }
+  if (pipelineWait(pipeline) != E_OK)
+    return 0;
+
+  pipeline->position += count;
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t pipelineWrite(void *object, const void *buffer, size_t length)
+{
+  struct DfuPipeline * const pipeline = object;
+
+  if (!pipeline->zerocopy)
+    return ifWrite(pipeline->flash, buffer, length);
+
+  /* Previous block should be programmed before the buffer is reused */
+  if (pipelineWait(pipeline) != E_OK)
+    return 0;
+  if (ifSetParam(pipeline->flash, IF_POSITION, &pipeline->position) != E_OK)
+    return 0;
+
+  length = MIN(length, pipeline->size);
+  memcpy(pipeline->buffer, buffer, length);
+
+  /* Tracked area is updated before the callback can erase ahead */
+  const uint32_t end = pipeline->position + (uint32_t)length;
+
+  if (pipeline->position >= pipeline->erasedBase
+      && end <= pipeline->erasedEnd)
+  {
+    pipeline->programmed = MAX(pipeline->programmed, end);
+  }
+  else
+  {
+    /* Data is written outside of the tracked area */
+    pipeline->erasedBase = 0;
+    pipeline->erasedEnd = 0;
+    pipeline->programmed = 0;
+  }
+
+  pipeline->state = DFU_PIPELINE_PROGRAM;
+
+  const size_t count = ifWrite(pipeline->flash, pipeline->buffer, length);
+
+  if (count != length)
+  {
+    /* Operation was not started, the callback will not be called */
+    if (!count)
+      pipeline->state = DFU_PIPELINE_IDLE;
+    return 0;
+  }
+
+  /* Programming continues while the bridge receives the next block */
+  pipeline->position = end;
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Calculate the DFU transfer size. Transfers never cross boundaries
+ * of erase units, so that each unit is programmed with whole transfers.
+ * @param geometry Array with memory regions.
+ * @param regions Number of memory regions.
+ * @param limit Maximum transfer size allowed by available RAM.
+ * @return Largest power of two not exceeding the limit that divides sizes
+ * of all erase units, but not less than the control endpoint packet size.
+ */
+size_t dfuCalcTransferSize(const struct FlashGeometry *geometry,
+    size_t regions, size_t limit)
+{
+  size_t size = DFU_TRANSFER_MAX;
+
+  while (size > DFU_TRANSFER_MIN && size > limit)
+    size >>= 1;
+
+  for (size_t i = 0; i < regions; ++i)
+  {
+    while (size > DFU_TRANSFER_MIN && geometry[i].size % size)
+      size >>= 1;
+  }
+
+  return size;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Get the download rate achieved by the bootloader, including USB transfers.
+ * @param monitor Pointer to a monitor object.
+ * @return Download rate in bytes per second.
+ */
+uint32_t dfuMonitorGetDownloadRate(const struct DfuMonitor *monitor)
+{
+  return calcRate(monitor, monitor->downloaded,
+      monitor->downloadEnd - monitor->downloadStart);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Get the average erase time of a memory erase unit.
+ * @param monitor Pointer to a monitor object.
+ * @return Erase time in microseconds.
+ */
+uint32_t dfuMonitorGetEraseTime(const struct DfuMonitor *monitor)
+{
+  if (!monitor->erased)
+    return 0;
+
+  const uint64_t frequency = timerGetFrequency(monitor->timer);
+  return (uint32_t)((uint64_t)monitor->eraseTime * 1000000
+      / monitor->erased / frequency);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Format the statistics of the last download and upload. The report has
+ * a fixed length and can be wrapped into a USB string descriptor.
+ * @param monitor Pointer to a monitor object.
+ * @param buffer Output buffer for at least DFU_MONITOR_REPORT_LENGTH + 1
+ * characters, the report is terminated with a null character.
+ */
+void dfuMonitorGetReport(const struct DfuMonitor *monitor, char *buffer)
+{
+  char *position = buffer;
+
+  position = appendText(position, "download ");
+  position = appendValue(position, dfuMonitorGetDownloadRate(monitor));
+  position = appendText(position, " B/s, erase ");
+  position = appendValue(position, dfuMonitorGetEraseTime(monitor));
+  position = appendText(position, " us, upload ");
+  position = appendValue(position, dfuMonitorGetUploadRate(monitor));
+  position = appendText(position, " B/s");
+  *position = '\0';
+
+  assert(position - buffer == DFU_MONITOR_REPORT_LENGTH);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Get the upload rate achieved by the bootloader, including USB transfers.
+ * @param monitor Pointer to a monitor object.
+ * @return Upload rate in bytes per second.
+ */
+uint32_t dfuMonitorGetUploadRate(const struct DfuMonitor *monitor)
+{
+  return calcRate(monitor, monitor->uploaded,
+      monitor->uploadEnd - monitor->uploadStart);
+}
@@ -0,0 +1,267 @@
+/*
+ * helpers/dfu_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_DFU_HELPERS_H_
+#define HELPERS_DFU_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/interface.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Transfer size limits: control endpoint packet and maximum DFU buffer */
+#define DFU_TRANSFER_MIN 64
+#define DFU_TRANSFER_MAX 4096
+/* Window size of the compressed image format, matches tools/pack_firmware.py */
+#define DFU_DECODER_WINDOW 4096
+/* Length of the monitor report without the terminating null character */
+#define DFU_MONITOR_REPORT_LENGTH 67
+
+extern const struct InterfaceClass * const DfuDecoder;
+extern const struct InterfaceClass * const DfuMonitor;
+extern const struct InterfaceClass * const DfuPatcher;
+extern const struct InterfaceClass * const DfuPipeline;
+
+struct FlashGeometry;
+struct Timer;
+
+enum [[gnu::packed]] DfuDecoderState
+{
+  /* Raw image or no download in progress */
+  DFU_DECODER_RAW,
+  DFU_DECODER_CONTROL,
+  DFU_DECODER_ITEM,
+  DFU_DECODER_MATCH,
+  DFU_DECODER_DONE,
+  DFU_DECODER_ERROR
+};
+
+enum [[gnu::packed]] DfuPatcherState
+{
+  /* Full image or no download in progress */
+  DFU_PATCHER_RAW,
+  DFU_PATCHER_COMMAND,
+  DFU_PATCHER_SOURCE,
+  DFU_PATCHER_INSERT,
+  DFU_PATCHER_DONE,
+  DFU_PATCHER_ERROR
+};
+
+enum [[gnu::packed]] DfuPipelineState
+{
+  DFU_PIPELINE_IDLE,
+  DFU_PIPELINE_ERASE,
+  DFU_PIPELINE_ERASE_AHEAD,
+  DFU_PIPELINE_PROGRAM,
+  DFU_PIPELINE_READ
+};
+
+struct DfuDecoderConfig
+{
+  /** Mandatory: memory interface. */
+  struct Interface *flash;
+  /** Mandatory: memory geometry. */
+  const struct FlashGeometry *geometry;
+  /** Mandatory: number of memory regions. */
+  size_t regions;
+  /** Mandatory: start of the firmware image. */
+  size_t offset;
+  /** Mandatory: size of the output buffer, equal to the transfer size. */
+  size_t size;
+};
+
+struct DfuDecoder
+{
+  struct Interface base;
+
+  struct Interface *flash;
+  const struct FlashGeometry *geometry;
+  size_t regions;
+
+  /* Sliding window with recently decoded data */
+  uint8_t *window;
+  /* Decoded data waiting to be programmed */
+  uint8_t *buffer;
+  size_t size;
+  size_t fill;
+
+  uint32_t offset;
+  uint32_t position;
+  /* End of the area erased by the decoder or by the bridge */
+  uint32_t erased;
+  /* Size of the decoded image and number of bytes decoded */
+  uint32_t length;
+  uint32_t decoded;
+  /* Position of the next byte in the window */
+  uint16_t head;
+
+  /* Control byte and number of items left in the current group */
+  uint8_t control;
+  uint8_t items;
+  /* First byte of the match reference */
+  uint8_t match;
+
+  enum DfuDecoderState state;
+};
+
+struct DfuMonitorConfig
+{
+  /** Mandatory: memory interface used by the DFU bridge. */
+  struct Interface *flash;
+  /** Mandatory: free-running timer for time measurements. */
+  struct Timer *timer;
+  /** Mandatory: start of the firmware image. */
+  size_t offset;
+};
+
+struct DfuMonitor
+{
+  struct Interface base;
+
+  struct Interface *flash;
+  struct Timer *timer;
+
+  uint32_t offset;
+  uint32_t position;
+
+  /* Time of the first and the last memory access of the transfer phase */
+  uint32_t downloadStart;
+  uint32_t downloadEnd;
+  uint32_t uploadStart;
+  uint32_t uploadEnd;
+
+  /* Statistics */
+  unsigned long downloaded;
+  unsigned long uploaded;
+  unsigned long erased;
+  /* Total and maximum erase time in timer ticks */
+  uint32_t eraseTime;
+  uint32_t eraseMax;
+};
+
+struct DfuPatcherConfig
+{
+  /**
+   * Mandatory: memory interface. Background operations are suspended
+   * with IF_BLOCKING while a patch is applied and resumed with IF_ZEROCOPY.
+   */
+  struct Interface *flash;
+  /** Mandatory: memory geometry. */
+  const struct FlashGeometry *geometry;
+  /** Mandatory: number of memory regions. */
+  size_t regions;
+  /** Mandatory: start of the firmware image. */
+  size_t offset;
+  /** Mandatory: size of the sector buffer, largest supported sector. */
+  size_t size;
+};
+
+struct DfuPatcher
+{
+  struct Interface base;
+
+  struct Interface *flash;
+  const struct FlashGeometry *geometry;
+  size_t regions;
+
+  /* New contents of the sector being rebuilt */
+  uint8_t *buffer;
+  size_t size;
+  size_t fill;
+
+  uint32_t offset;
+  uint32_t position;
+  /* Start and size of the sector being rebuilt */
+  uint32_t sector;
+  uint32_t sectorSize;
+
+  /* Sizes and checksums of the installed and the new images */
+  uint32_t sourceLength;
+  uint32_t sourceChecksum;
+  uint32_t length;
+  uint32_t checksum;
+  /* Number of bytes of the new image produced */
+  uint32_t produced;
+
+  /* Argument being decoded and length of the current command */
+  uint32_t argument;
+  uint32_t count;
+  uint8_t shift;
+
+  /* Statistics */
+  unsigned long rewritten;
+  unsigned long skipped;
+
+  /* Erase request for the first sector, deferred until the image is known */
+  int deferred;
+  enum DfuPatcherState state;
+  /* Background operations of the memory are suspended */
+  bool suspended;
+};
+
+struct DfuPipelineConfig
+{
+  /** Mandatory: memory interface. */
+  struct Interface *flash;
+  /** Mandatory: memory geometry. */
+  const struct FlashGeometry *geometry;
+  /** Mandatory: number of memory regions. */
+  size_t regions;
+  /** Mandatory: size of the program buffer, equal to the transfer size. */
+  size_t size;
+  /** Mandatory: length of the area kept erased ahead of the write pointer. */
+  uint32_t ahead;
+};
+
+struct DfuPipeline
+{
+  struct Interface base;
+
+  struct Interface *flash;
+  const struct FlashGeometry *geometry;
+  size_t regions;
+
+  /* Copy of the data being programmed */
+  uint8_t *buffer;
+  size_t size;
+
+  /* Memory capacity and erase block size, zero when not supported */
+  uint32_t capacity;
+  uint32_t block;
+  uint32_t ahead;
+
+  /* Erased area starting from the last erase requested by the bridge */
+  uint32_t erasedBase;
+  uint32_t erasedEnd;
+  /* End of the data programmed into the erased area */
+  uint32_t programmed;
+  /* End of the area being erased in the background */
+  uint32_t pending;
+  uint32_t position;
+
+  /* Statistics */
+  unsigned long erased;
+  unsigned long skipped;
+
+  /* Deferred status of the background operations */
+  enum Result status;
+  volatile enum DfuPipelineState state;
+  /* Memory supports zero-copy mode, otherwise requests are passed through */
+  bool zerocopy;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+size_t dfuCalcTransferSize(const struct FlashGeometry *, size_t, size_t);
+
+uint32_t dfuMonitorGetDownloadRate(const struct DfuMonitor *);
+uint32_t dfuMonitorGetEraseTime(const struct DfuMonitor *);
+void dfuMonitorGetReport(const struct DfuMonitor *, char *);
+uint32_t dfuMonitorGetUploadRate(const struct DfuMonitor *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_DFU_HELPERS_H_ */
@@ -6,9 +6,301 @@
 
 #include "display_helpers.h"
 #include <dpm/displays/display.h>
+#include <halm/timer.h>
 #include <xcore/memory.h>
+#include <string.h>
 /*----------------------------------------------------------------------------*/
-#define COLORS_TOTAL 7
+#define COLORS_TOTAL  7
+#define SPANS_MAX     16
+/*----------------------------------------------------------------------------*/
+struct FillSpan
+{
+  uint16_t length;
+  uint16_t value;
+};
+
+struct FillPattern
+{
+  /* Pattern-specific state */
+  const void *argument;
+  /* Fill spans of the row, returns number of spans */
+  size_t (*row)(const void *, uint16_t, uint16_t, struct FillSpan *);
+};
+
+struct ChessPattern
+{
+  uint16_t colorA;
+  uint16_t colorB;
+  uint16_t div;
+};
+
+struct GradientPattern
+{
+  Color colorA;
+  Color colorB;
+  uint16_t height;
+};
+
+struct MarkerPattern
+{
+  uint16_t colorA;
+  uint16_t colorB;
+  uint16_t divX;
+  uint16_t divY;
+};
+/*----------------------------------------------------------------------------*/
+static void arenaBegin(struct DisplayArena *);
+static void arenaEnd(struct DisplayArena *);
+static uint32_t arenaTicks(const struct DisplayArena *);
+static void arenaWait(struct DisplayArena *);
+static void arenaWrite(struct DisplayArena *, const void *, size_t);
+static void onArenaTransferCompleted(void *);
+static size_t chessRow(const void *, uint16_t, uint16_t, struct FillSpan *);
+static size_t gradientRow(const void *, uint16_t, uint16_t, struct FillSpan *);
+static size_t markerRow(const void *, uint16_t, uint16_t, struct FillSpan *);
+static void fillPattern(struct DisplayArena *, const struct FillPattern *);
+static void fillSpan(uint16_t *, uint16_t, size_t);
+static bool spansEqual(const struct FillSpan *, size_t,
+    const struct FillSpan *, size_t);
+/*----------------------------------------------------------------------------*/
+static void arenaBegin(struct DisplayArena *arena)
+{
+  arena->total = arenaTicks(arena);
+  arena->wait = 0;
+}
+/*----------------------------------------------------------------------------*/
+static void arenaEnd(struct DisplayArena *arena)
+{
+  arenaWait(arena);
+  arena->total = arenaTicks(arena) - arena->total;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t arenaTicks(const struct DisplayArena *arena)
+{
+  return arena->timer != NULL ? timerGetValue(arena->timer) : 0;
+}
+/*----------------------------------------------------------------------------*/
+static void arenaWait(struct DisplayArena *arena)
+{
+  if (arena->busy)
+  {
+    const uint32_t start = arenaTicks(arena);
+
+    while (arena->busy);
+    arena->wait += arenaTicks(arena) - start;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void arenaWrite(struct DisplayArena *arena, const void *buffer,
+    size_t length)
+{
+  arenaWait(arena);
+
+  if (arena->zerocopy)
+  {
+    /* Completion callback clears the flag, buffer should not be changed */
+    arena->busy = true;
+
+    if (ifWrite(arena->display, buffer, length) != length)
+      arena->busy = false;
+  }
+  else
+  {
+    const uint32_t start = arenaTicks(arena);
+
+    ifWrite(arena->display, buffer, length);
+    arena->wait += arenaTicks(arena) - start;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void onArenaTransferCompleted(void *argument)
+{
+  struct DisplayArena * const arena = argument;
+  arena->busy = false;
+}
+/*----------------------------------------------------------------------------*/
+static size_t chessRow(const void *argument, uint16_t width, uint16_t y,
+    struct FillSpan *spans)
+{
+  const struct ChessPattern * const pattern = argument;
+  const bool odd = (y / pattern->div) & 1;
+  size_t count = 0;
+
+  for (uint16_t x = 0; x < width;)
+  {
+    const bool column = count & 1;
+    /* The last span is extended to the end of the row */
+    const uint16_t length = count < SPANS_MAX - 1 ?
+        MIN(pattern->div, width - x) : width - x;
+
+    spans[count++] = (struct FillSpan){
+        .length = length,
+        .value = column == odd ? pattern->colorA : pattern->colorB
+    };
+    x += length;
+  }
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t gradientRow(const void *argument, uint16_t width, uint16_t y,
+    struct FillSpan *spans)
+{
+  const struct GradientPattern * const pattern = argument;
+
+  spans[0] = (struct FillSpan){
+      .length = width,
+      .value = rgbTo565(interpolateColor(pattern->colorA, pattern->colorB,
+          y, pattern->height))
+  };
+  return 1;
+}
+/*----------------------------------------------------------------------------*/
+static size_t markerRow(const void *argument, uint16_t width, uint16_t y,
+    struct FillSpan *spans)
+{
+  const struct MarkerPattern * const pattern = argument;
+  const uint16_t band = y / pattern->divY;
+  uint16_t values[6];
+
+  switch (band)
+  {
+    case 1:
+    case 3:
+      values[0] = values[4] = pattern->colorB;
+      values[1] = values[2] = values[3] = values[5] = pattern->colorA;
+      break;
+
+    case 2:
+    case 4:
+    case 5:
+      values[1] = pattern->colorA;
+      values[0] = values[2] = values[3] = values[4] = values[5] =
+          pattern->colorB;
+      break;
+
+    default:
+      spans[0] = (struct FillSpan){width, pattern->colorB};
+      return 1;
+  }
+
+  /* Five columns and a remainder when the width is not a multiple of 5 */
+  size_t count = 0;
+
+  for (uint16_t x = 0, column = 0; x < width; ++column)
+  {
+    const uint16_t length = column < 5 ?
+        MIN(pattern->divX, width - x) : width - x;
+
+    spans[count++] = (struct FillSpan){length, values[column]};
+    x += length;
+  }
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static void fillPattern(struct DisplayArena *arena,
+    const struct FillPattern *pattern)
+{
+  struct DisplayResolution resolution;
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
+
+  /* In zero-copy mode one half is rendered while the other is transferred */
+  const size_t capacity = arena->zerocopy ? arena->size / 2 : arena->size;
+  const size_t width = resolution.width;
+  const size_t lines = MIN(capacity / width, resolution.height);
+
+  if (!lines)
+    return;
+
+  struct FillSpan previous[SPANS_MAX];
+  size_t previousCount = 0;
+  uint16_t *buffer = arena->buffer;
+  size_t line = 0;
+
+  for (uint16_t y = 0; y < resolution.height; ++y)
+  {
+    struct FillSpan spans[SPANS_MAX];
+    const size_t count = pattern->row(pattern->argument, resolution.width,
+        y, spans);
+    uint16_t * const position = buffer + line * width;
+
+    if (line > 0 && spansEqual(spans, count, previous, previousCount))
+    {
+      /* Rows inside the same band are identical, copy the whole row */
+      memcpy(position, position - width, width * sizeof(uint16_t));
+    }
+    else
+    {
+      uint16_t *current = position;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        fillSpan(current, spans[i].value, spans[i].length);
+        current += spans[i].length;
+      }
+
+      memcpy(previous, spans, count * sizeof(struct FillSpan));
+      previousCount = count;
+    }
+
+    if (++line == lines)
+    {
+      arenaWrite(arena, buffer, lines * width * sizeof(uint16_t));
+      line = 0;
+
+      if (arena->zerocopy)
+      {
+        buffer = buffer == arena->buffer ?
+            arena->buffer + capacity : arena->buffer;
+      }
+    }
+  }
+
+  if (line > 0)
+    arenaWrite(arena, buffer, line * width * sizeof(uint16_t));
+}
+/*----------------------------------------------------------------------------*/
+static void fillSpan(uint16_t *buffer, uint16_t value, size_t count)
+{
+  if (count && ((uintptr_t)buffer & 2))
+  {
+    *buffer++ = value;
+    --count;
+  }
+
+  /*
+   * Buffer is aligned on a 4-byte boundary, store two pixels at once.
+   * Stores go through memcpy because the arena holds 16-bit pixels,
+   * the compiler emits them as single word stores.
+   */
+  const uint16_t pair[2] = {value, value};
+  uint8_t *words = __builtin_assume_aligned(buffer, 4);
+  size_t pairs = count >> 1;
+
+  for (; pairs >= 4; pairs -= 4)
+  {
+    memcpy(words, pair, sizeof(pair));
+    memcpy(words + 4, pair, sizeof(pair));
+    memcpy(words + 8, pair, sizeof(pair));
+    memcpy(words + 12, pair, sizeof(pair));
+    words += 16;
+  }
+  while (pairs--)
+  {
+    memcpy(words, pair, sizeof(pair));
+    words += sizeof(pair);
+  }
+
+  if (count & 1)
+    memcpy(words, &value, sizeof(value));
+}
+/*----------------------------------------------------------------------------*/
+static bool spansEqual(const struct FillSpan *a, size_t aCount,
+    const struct FillSpan *b, size_t bCount)
+{
+  return aCount == bCount && !memcmp(a, b, aCount * sizeof(struct FillSpan));
+}
 /*----------------------------------------------------------------------------*/
 Color interpolateColor(Color a, Color b, int current, int total)
 {
@@ -45,77 +337,103 @@ uint16_t rgbTo565(Color color)
   return toBigEndian16((r << 11) | (g << 5) | b);
 }
 /*----------------------------------------------------------------------------*/
-void handleChessFill(struct Interface *display, unsigned int color,
-    unsigned int style, void *buffer, size_t)
+void displayArenaInit(struct DisplayArena *arena, struct Interface *display,
+    struct Timer *timer, void *buffer, size_t size)
 {
-  const uint16_t colorA = style & 1 ?
-      rgbTo565(makeColor(color)) : rgbTo565((Color){0, 0, 0});
-  const uint16_t colorB = style & 1 ?
-      rgbTo565((Color){0, 0, 0}) : rgbTo565(makeColor(color));
-  uint16_t * const arena = buffer;
-  struct DisplayResolution resolution;
-
-  ifGetParam(display, IF_DISPLAY_RESOLUTION, &resolution);
-
-  const uint16_t div = resolution.width / 8;
+  arena->display = display;
+  arena->timer = timer;
+  arena->buffer = buffer;
+  arena->size = size;
+  arena->total = 0;
+  arena->wait = 0;
+  arena->busy = false;
+  arena->zerocopy = false;
+}
+/*----------------------------------------------------------------------------*/
+bool displayArenaSetZeroCopy(struct DisplayArena *arena, bool state)
+{
+  arenaWait(arena);
 
-  for (uint16_t y = 0; y < resolution.height; ++y)
+  if (state)
   {
-    if ((y / div) & 1)
-    {
-      for (uint16_t x = 0; x < resolution.width; ++x)
-        arena[x] = ((x / div) & 1) ? colorA : colorB;
-    }
-    else
-    {
-      for (uint16_t x = 0; x < resolution.width; ++x)
-        arena[x] = ((x / div) & 1) ? colorB : colorA;
-    }
-
-    ifWrite(display, arena, resolution.width * sizeof(uint16_t));
+    if (ifSetParam(arena->display, IF_ZEROCOPY, NULL) != E_OK)
+      return false;
+    ifSetCallback(arena->display, onArenaTransferCompleted, arena);
   }
+  else
+  {
+    ifSetParam(arena->display, IF_BLOCKING, NULL);
+    ifSetCallback(arena->display, NULL, NULL);
+  }
+
+  arena->zerocopy = state;
+  return true;
 }
 /*----------------------------------------------------------------------------*/
-void handleGradientFill(struct Interface *display, unsigned int color,
-    unsigned int style, void *buffer, size_t)
+void handleChessFill(struct DisplayArena *arena, unsigned int color,
+    unsigned int style)
 {
-  const Color colorA = style & 1 ? makeColor(color) : (Color){0, 0, 0};
-  const Color colorB = style & 1 ? (Color){0, 0, 0} : makeColor(color);
-  uint16_t * const arena = buffer;
   struct DisplayResolution resolution;
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
 
-  ifGetParam(display, IF_DISPLAY_RESOLUTION, &resolution);
+  const struct ChessPattern chess = {
+      .colorA = style & 1 ?
+          rgbTo565(makeColor(color)) : rgbTo565((Color){0, 0, 0}),
+      .colorB = style & 1 ?
+          rgbTo565((Color){0, 0, 0}) : rgbTo565(makeColor(color)),
+      .div = MAX(resolution.width / 8, 1)
+  };
+  const struct FillPattern pattern = {
+      .argument = &chess,
+      .row = chessRow
+  };
 
-  for (uint16_t y = 0; y < resolution.height; ++y)
-  {
-    const uint16_t value =
-        rgbTo565(interpolateColor(colorA, colorB, y, resolution.height));
+  arenaBegin(arena);
+  fillPattern(arena, &pattern);
+  arenaEnd(arena);
+}
+/*----------------------------------------------------------------------------*/
+void handleGradientFill(struct DisplayArena *arena, unsigned int color,
+    unsigned int style)
+{
+  struct DisplayResolution resolution;
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
 
-    for (uint16_t x = 0; x < resolution.width; ++x)
-      arena[x] = value;
+  const struct GradientPattern gradient = {
+      .colorA = style & 1 ? makeColor(color) : (Color){0, 0, 0},
+      .colorB = style & 1 ? (Color){0, 0, 0} : makeColor(color),
+      .height = resolution.height
+  };
+  const struct FillPattern pattern = {
+      .argument = &gradient,
+      .row = gradientRow
+  };
 
-    ifWrite(display, arena, resolution.width * sizeof(uint16_t));
-  }
+  arenaBegin(arena);
+  fillPattern(arena, &pattern);
+  arenaEnd(arena);
 }
 /*----------------------------------------------------------------------------*/
-void handleLineFill(struct Interface *display, unsigned int color,
-    unsigned int style, void *buffer, size_t size)
+void handleLineFill(struct DisplayArena *arena, unsigned int color,
+    unsigned int style)
 {
   const unsigned int index = style % 3;
   const uint16_t colorA = rgbTo565(makeColor(color));
   const uint16_t colorB = rgbTo565((Color){0, 0, 0});
-  uint16_t * const arena = buffer;
+  uint16_t * const pixels = arena->buffer;
   struct DisplayResolution resolution;
 
-  ifGetParam(display, IF_DISPLAY_RESOLUTION, &resolution);
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
 
-  const uint16_t lines = (size / resolution.width) & ~1;
+  const uint16_t lines = (arena->size / resolution.width) & ~1;
+
+  arenaBegin(arena);
 
   switch (index)
   {
     case 1:
       for (size_t i = 0; i < (size_t)lines * resolution.width; ++i)
-        arena[i] = (i & 1) ? colorA : colorB;
+        pixels[i] = (i & 1) ? colorA : colorB;
       break;
 
     case 2:
@@ -124,9 +442,9 @@ void handleLineFill(struct Interface *display, unsigned int color,
         for (uint16_t x = 0; x < resolution.width; ++x)
         {
           if (y & 1)
-            arena[y * resolution.width + x] = colorA;
+            pixels[y * resolution.width + x] = colorA;
           else
-            arena[y * resolution.width + x] = colorB;
+            pixels[y * resolution.width + x] = colorB;
         }
       }
       break;
@@ -137,9 +455,9 @@ void handleLineFill(struct Interface *display, unsigned int color,
         for (uint16_t x = 0; x < resolution.width; ++x)
         {
           if (y & 1)
-            arena[y * resolution.width + x] = (x & 1) ? colorA : colorB;
+            pixels[y * resolution.width + x] = (x & 1) ? colorA : colorB;
           else
-            arena[y * resolution.width + x] = (x & 1) ? colorB : colorA;
+            pixels[y * resolution.width + x] = (x & 1) ? colorB : colorA;
         }
       }
       break;
@@ -149,71 +467,49 @@ void handleLineFill(struct Interface *display, unsigned int color,
   {
     const size_t count = MIN(lines, resolution.height - row);
 
-    ifWrite(display, arena, count * resolution.width * sizeof(uint16_t));
+    arenaWrite(arena, pixels, count * resolution.width * sizeof(uint16_t));
     row += count;
   }
+
+  arenaEnd(arena);
 }
 /*----------------------------------------------------------------------------*/
-void handleMarkerFill(struct Interface *display, unsigned int color,
-    unsigned int style, void *buffer, size_t)
+void handleMarkerFill(struct DisplayArena *arena, unsigned int color,
+    unsigned int style)
 {
-  const uint16_t colorA = style & 1 ?
-      rgbTo565((Color){0, 0, 0}) : rgbTo565(makeColor(color));
-  const uint16_t colorB = style & 1 ?
-      rgbTo565(makeColor(color)) : rgbTo565((Color){0, 0, 0});
-  uint16_t * const arena = buffer;
   struct DisplayResolution resolution;
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
 
-  ifGetParam(display, IF_DISPLAY_RESOLUTION, &resolution);
-
-  const uint16_t divX = resolution.width / 5;
-  const uint16_t divY = resolution.height / 7;
-
-  for (uint16_t y = 0; y < resolution.height; ++y)
-  {
-    switch (y / divY)
-    {
-      case 1:
-      case 3:
-        for (uint16_t x = 0; x < resolution.width; ++x)
-        {
-          const uint16_t column = x / divX;
-          arena[x] = (column == 0 || column == 4) ? colorB : colorA;
-        }
-        break;
-
-      case 2:
-      case 4:
-      case 5:
-        for (uint16_t x = 0; x < resolution.width; ++x)
-        {
-          const uint16_t column = x / divX;
-          arena[x] = (column == 1) ? colorA : colorB;
-        }
-        break;
-
-      default:
-        for (uint16_t x = 0; x < resolution.width; ++x)
-          arena[x] = colorB;
-        break;
-    }
+  const struct MarkerPattern marker = {
+      .colorA = style & 1 ?
+          rgbTo565((Color){0, 0, 0}) : rgbTo565(makeColor(color)),
+      .colorB = style & 1 ?
+          rgbTo565(makeColor(color)) : rgbTo565((Color){0, 0, 0}),
+      .divX = MAX(resolution.width / 5, 1),
+      .divY = MAX(resolution.height / 7, 1)
+  };
+  const struct FillPattern pattern = {
+      .argument = &marker,
+      .row = markerRow
+  };
 
-    ifWrite(display, arena, resolution.width * sizeof(uint16_t));
-  }
+  arenaBegin(arena);
+  fillPattern(arena, &pattern);
+  arenaEnd(arena);
 }
 /*----------------------------------------------------------------------------*/
-void handleSolidFill(struct Interface *display, unsigned int color,
-    unsigned int, void *buffer, size_t size)
+void handleSolidFill(struct DisplayArena *arena, unsigned int color,
+    unsigned int)
 {
   const unsigned int index = color % (COLORS_TOTAL + 1);
   const uint16_t value = index > 0 ?
       rgbTo565(makeColor(color)) : rgbTo565((Color){0, 0, 0});
-  uint16_t * const arena = buffer;
+  uint16_t * const pixels = arena->buffer;
   struct DisplayResolution resolution;
 
-  ifGetParam(display, IF_DISPLAY_RESOLUTION, &resolution);
+  ifGetParam(arena->display, IF_DISPLAY_RESOLUTION, &resolution);
 
-  const uint16_t lines = size / resolution.width;
+  const uint16_t lines = arena->size / resolution.width;
   const struct DisplayWindow window = {
       .ax = 0,
       .ay = 0,
@@ -221,15 +517,17 @@ void handleSolidFill(struct Interface *display, unsigned int color,
       .by = resolution.height - 1
   };
 
-  for (size_t i = 0; i < (size_t)lines * resolution.width; ++i)
-    arena[i] = value;
+  arenaBegin(arena);
+  fillSpan(pixels, value, (size_t)lines * resolution.width);
 
-  ifSetParam(display, IF_DISPLAY_WINDOW, &window);
+  ifSetParam(arena->display, IF_DISPLAY_WINDOW, &window);
   for (uint16_t row = 0; row < resolution.height;)
   {
     const size_t count = MIN(lines, resolution.height - row);
 
-    ifWrite(display, arena, count * resolution.width * sizeof(uint16_t));
+    arenaWrite(arena, pixels, count * resolution.width * sizeof(uint16_t));
     row += count;
   }
+
+  arenaEnd(arena);
 }
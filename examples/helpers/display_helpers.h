@@ -8,6 +8,7 @@
 #define HELPERS_DISPLAY_HELPERS_H_
 /*----------------------------------------------------------------------------*/
 #include <xcore/helpers.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 /*----------------------------------------------------------------------------*/
@@ -19,6 +20,29 @@ typedef struct
 } Color;
 
 struct Interface;
+struct Timer;
+
+struct DisplayArena
+{
+  struct Interface *display;
+  /* Optional timer for page statistics */
+  struct Timer *timer;
+
+  /* Pixel buffer, split in two halves in zero-copy mode */
+  uint16_t *buffer;
+  /* Buffer size in pixels */
+  size_t size;
+
+  /* Duration of the last page in timer ticks */
+  uint32_t total;
+  /* Time spent waiting for the bus during the last page */
+  uint32_t wait;
+
+  /* Transfer is in progress */
+  volatile bool busy;
+  /* Pages are rendered into one half while the other one is transferred */
+  bool zerocopy;
+};
 /*----------------------------------------------------------------------------*/
 BEGIN_DECLS
 
@@ -26,16 +50,15 @@ Color interpolateColor(Color a, Color b, int current, int total);
 Color makeColor(unsigned int);
 uint16_t rgbTo565(Color);
 
-void handleChessFill(struct Interface *, unsigned int, unsigned int,
-    void *, size_t);
-void handleGradientFill(struct Interface *, unsigned int, unsigned int,
-    void *, size_t);
-void handleLineFill(struct Interface *, unsigned int, unsigned int,
-    void *, size_t);
-void handleMarkerFill(struct Interface *, unsigned int, unsigned int,
-    void *, size_t);
-void handleSolidFill(struct Interface *, unsigned int, unsigned int,
-    void *, size_t);
+void displayArenaInit(struct DisplayArena *, struct Interface *,
+    struct Timer *, void *, size_t);
+bool displayArenaSetZeroCopy(struct DisplayArena *, bool);
+
+void handleChessFill(struct DisplayArena *, unsigned int, unsigned int);
+void handleGradientFill(struct DisplayArena *, unsigned int, unsigned int);
+void handleLineFill(struct DisplayArena *, unsigned int, unsigned int);
+void handleMarkerFill(struct DisplayArena *, unsigned int, unsigned int);
+void handleSolidFill(struct DisplayArena *, unsigned int, unsigned int);
 
 END_DECLS
 /*----------------------------------------------------------------------------*/
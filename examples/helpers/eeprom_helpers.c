@@ -0,0 +1,388 @@
+/*
+ * helpers/eeprom_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "eeprom_helpers.h"
+#include <halm/timer.h>
+#include <xcore/interface.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Start, stop and address bytes of a write request with 16-bit addressing */
+#define WRITE_OVERHEAD_BITS (2 + 3 * 9)
+/*----------------------------------------------------------------------------*/
+static uint32_t benchmarkRate(const struct EepromBenchmark *, uint32_t,
+    uint32_t);
+/*----------------------------------------------------------------------------*/
+static inline bool combinerIsDirty(const struct EepromCombiner *combiner,
+    size_t offset)
+{
+  return (combiner->mask[offset >> 3] & (1 << (offset & 7))) != 0;
+}
+/*----------------------------------------------------------------------------*/
+/* Convert the number of bytes processed in a time interval to bytes/s */
+static uint32_t benchmarkRate(const struct EepromBenchmark *benchmark,
+    uint32_t length, uint32_t ticks)
+{
+  const uint64_t frequency = timerGetFrequency(benchmark->timer);
+
+  if (!ticks)
+    ticks = 1;
+
+  return (uint32_t)(((uint64_t)length * frequency) / ticks);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a write-combining cache.
+ * @param combiner Pointer to a combiner object.
+ * @param memory EEPROM interface.
+ * @param page Page size of the memory.
+ * @param size Cache size, should be a multiple of the page size and
+ * should not exceed @b EEPROM_COMBINER_MAX.
+ * @return @b true on success.
+ */
+bool eepromCombinerInit(struct EepromCombiner *combiner,
+    struct Interface *memory, uint32_t page, uint32_t size)
+{
+  if (!page || size < page || size % page || size > EEPROM_COMBINER_MAX)
+    return false;
+  if (size / page > EEPROM_COMBINER_SLOTS)
+    return false;
+
+  combiner->memory = memory;
+  combiner->page = page;
+  combiner->slots = size / page;
+  combiner->used = 0;
+  combiner->flushes = 0;
+  combiner->pages = 0;
+  combiner->requests = 0;
+  memset(combiner->mask, 0, sizeof(combiner->mask));
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Write all cached pages to the memory in ascending address order.
+ * Each page costs exactly one write cycle: unmodified bytes between modified
+ * ones are read from the memory first and written back with new data.
+ * @param combiner Pointer to a combiner object.
+ * @return @b E_OK on success.
+ */
+enum Result eepromCombinerFlush(struct EepromCombiner *combiner)
+{
+  uint8_t order[EEPROM_COMBINER_SLOTS];
+
+  if (!combiner->used)
+    return E_OK;
+
+  /* Insertion sort of slot indices by page address */
+  for (uint32_t i = 0; i < combiner->used; ++i)
+  {
+    uint32_t j = i;
+
+    while (j > 0 && combiner->tags[order[j - 1]] > combiner->tags[i])
+    {
+      order[j] = order[j - 1];
+      --j;
+    }
+    order[j] = (uint8_t)i;
+  }
+
+  for (uint32_t index = 0; index < combiner->used; ++index)
+  {
+    const size_t base = order[index] * combiner->page;
+    size_t first = base;
+    size_t last = base + combiner->page;
+    bool gaps = false;
+
+    while (!combinerIsDirty(combiner, first))
+      ++first;
+    while (!combinerIsDirty(combiner, last - 1))
+      --last;
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (!combinerIsDirty(combiner, i))
+      {
+        gaps = true;
+        break;
+      }
+    }
+
+    const size_t length = last - first;
+    const uint32_t position = combiner->tags[order[index]] + (first - base);
+    enum Result res;
+
+    if (gaps)
+    {
+      uint8_t original[length];
+
+      res = ifSetParam(combiner->memory, IF_POSITION, &position);
+      if (res != E_OK)
+        return res;
+      if (ifRead(combiner->memory, original, length) != length)
+        return E_INTERFACE;
+
+      for (size_t i = first; i < last; ++i)
+      {
+        if (!combinerIsDirty(combiner, i))
+          combiner->data[i] = original[i - first];
+      }
+    }
+
+    res = ifSetParam(combiner->memory, IF_POSITION, &position);
+    if (res != E_OK)
+      return res;
+    if (ifWrite(combiner->memory, combiner->data + first, length) != length)
+      return E_INTERFACE;
+  }
+
+  memset(combiner->mask, 0, sizeof(combiner->mask));
+  combiner->pages += combiner->used;
+  combiner->used = 0;
+  ++combiner->flushes;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Buffer a write request. All cached pages are flushed when the request
+ * touches a new page and the cache is full, the caller should flush
+ * the cache explicitly after the last request.
+ * @param combiner Pointer to a combiner object.
+ * @param position Memory address.
+ * @param buffer Pointer to a buffer with data.
+ * @param length Length of data.
+ * @return @b E_OK on success.
+ */
+enum Result eepromCombinerWrite(struct EepromCombiner *combiner,
+    uint32_t position, const void *buffer, size_t length)
+{
+  const uint8_t *input = buffer;
+
+  ++combiner->requests;
+
+  while (length)
+  {
+    const uint32_t tag = position - position % combiner->page;
+    uint32_t slot = 0;
+
+    while (slot < combiner->used && combiner->tags[slot] != tag)
+      ++slot;
+
+    if (slot == combiner->used)
+    {
+      if (combiner->used == combiner->slots)
+      {
+        const enum Result res = eepromCombinerFlush(combiner);
+
+        if (res != E_OK)
+          return res;
+        slot = 0;
+      }
+
+      combiner->tags[slot] = tag;
+      ++combiner->used;
+    }
+
+    const size_t offset = slot * combiner->page + (position - tag);
+    const size_t chunk = MIN(length, combiner->page - (position - tag));
+
+    memcpy(combiner->data + offset, input, chunk);
+    for (size_t i = offset; i < offset + chunk; ++i)
+      combiner->mask[i >> 3] |= 1 << (i & 7);
+
+    position += chunk;
+    input += chunk;
+    length -= chunk;
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize an EEPROM benchmark object.
+ * @param benchmark Pointer to a benchmark object.
+ * @param memory EEPROM interface in blocking mode.
+ * @param timer Free-running timer used for time measurements.
+ * @param buffer Transfer buffer.
+ * @param size Size of the buffer and of the benchmark region.
+ * @param position Start of the benchmark region, aligned to the page size.
+ * @param page Page size of the memory.
+ * @return @b true on success.
+ */
+bool eepromBenchmarkInit(struct EepromBenchmark *benchmark,
+    struct Interface *memory, struct Timer *timer, void *buffer, size_t size,
+    uint32_t position, uint32_t page)
+{
+  uint32_t capacity = 0;
+
+  if (!page || !size || size % page || position % page)
+    return false;
+  if (ifGetParam(memory, IF_SIZE, &capacity) != E_OK)
+    return false;
+  if (position + size > capacity)
+    return false;
+
+  benchmark->memory = memory;
+  benchmark->timer = timer;
+  benchmark->buffer = buffer;
+  benchmark->size = size;
+  benchmark->position = position;
+  benchmark->page = page;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Measure the time spent in write cycles and acknowledge polling.
+ * Single pages are written and the time of the bus transfer is subtracted
+ * from the average time of the request.
+ * @param benchmark Pointer to a benchmark object.
+ * @param rate Bus rate in Hz.
+ * @return Overhead per page in microseconds or zero on failure.
+ */
+uint32_t eepromBenchmarkPollTime(struct EepromBenchmark *benchmark,
+    uint32_t rate)
+{
+  const uint32_t pages = benchmark->size / benchmark->page;
+  const uint64_t frequency = timerGetFrequency(benchmark->timer);
+
+  for (size_t i = 0; i < benchmark->page; ++i)
+    benchmark->buffer[i] = (uint8_t)~i;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t index = 0; index < pages; ++index)
+  {
+    const uint32_t position = benchmark->position + index * benchmark->page;
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifWrite(benchmark->memory, benchmark->buffer, benchmark->page)
+        != benchmark->page)
+    {
+      return 0;
+    }
+  }
+
+  const uint32_t ticks = timerGetValue(benchmark->timer) - start;
+  const uint64_t average = (uint64_t)ticks * 1000000 / (frequency * pages);
+  const uint64_t transfer = (uint64_t)(WRITE_OVERHEAD_BITS
+      + benchmark->page * 9) * 1000000 / rate;
+
+  return average > transfer ? (uint32_t)(average - transfer) : 0;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Write small records at pseudo-random positions inside the region.
+ * @param benchmark Pointer to a benchmark object.
+ * @param combiner Pointer to a combiner object or @b NULL for direct writes.
+ * @param record Length of a single record.
+ * @param count Number of records.
+ * @return Payload bandwidth in bytes/s or zero on failure.
+ */
+uint32_t eepromBenchmarkRandom(struct EepromBenchmark *benchmark,
+    struct EepromCombiner *combiner, size_t record, size_t count)
+{
+  if (!record || record > benchmark->size)
+    return 0;
+
+  const uint32_t slots = benchmark->size / record;
+  uint32_t seed = 0;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    seed = seed * 1664525UL + 1013904223UL;
+
+    const uint32_t offset = (seed >> 8) % slots * record;
+    const uint32_t position = benchmark->position + offset;
+    uint8_t data[record];
+
+    for (size_t i = 0; i < record; ++i)
+      data[i] = (uint8_t)(offset + i + index);
+
+    if (combiner != NULL)
+    {
+      if (eepromCombinerWrite(combiner, position, data, record) != E_OK)
+        return 0;
+    }
+    else
+    {
+      if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+        return 0;
+      if (ifWrite(benchmark->memory, data, record) != record)
+        return 0;
+    }
+  }
+
+  if (combiner != NULL && eepromCombinerFlush(combiner) != E_OK)
+    return 0;
+
+  return benchmarkRate(benchmark, record * count,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Read the region with chunks of the specified length.
+ * @param benchmark Pointer to a benchmark object.
+ * @param chunk Length of a single read request.
+ * @return Bandwidth in bytes/s or zero on failure.
+ */
+uint32_t eepromBenchmarkRead(struct EepromBenchmark *benchmark, size_t chunk)
+{
+  if (!chunk || benchmark->size % chunk)
+    return 0;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t offset = 0; offset < benchmark->size; offset += chunk)
+  {
+    const uint32_t position = benchmark->position + offset;
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifRead(benchmark->memory, benchmark->buffer + offset, chunk) != chunk)
+      return 0;
+  }
+
+  return benchmarkRate(benchmark, benchmark->size,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Write the region with chunks of the specified length. Chunks are aligned
+ * to the page size, the driver splits them into page writes.
+ * @param benchmark Pointer to a benchmark object.
+ * @param chunk Length of a single write request.
+ * @return Bandwidth in bytes/s or zero on failure.
+ */
+uint32_t eepromBenchmarkWrite(struct EepromBenchmark *benchmark, size_t chunk)
+{
+  if (!chunk || benchmark->size % chunk)
+    return 0;
+
+  for (size_t i = 0; i < benchmark->size; ++i)
+    benchmark->buffer[i] = (uint8_t)i;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t offset = 0; offset < benchmark->size; offset += chunk)
+  {
+    const uint32_t position = benchmark->position + offset;
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifWrite(benchmark->memory, benchmark->buffer + offset, chunk)
+        != chunk)
+    {
+      return 0;
+    }
+  }
+
+  return benchmarkRate(benchmark, benchmark->size,
+      timerGetValue(benchmark->timer) - start);
+}
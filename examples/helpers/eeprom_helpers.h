@@ -0,0 +1,76 @@
+/*
+ * helpers/eeprom_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_EEPROM_HELPERS_H_
+#define HELPERS_EEPROM_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Maximum size of the write-combining cache */
+#define EEPROM_COMBINER_MAX   256
+/* Maximum number of cached pages */
+#define EEPROM_COMBINER_SLOTS 16
+
+struct Interface;
+struct Timer;
+
+struct EepromCombiner
+{
+  struct Interface *memory;
+
+  /* Page size of the memory */
+  uint32_t page;
+  /* Number of page slots and number of slots in use */
+  uint32_t slots;
+  uint32_t used;
+
+  /* Statistics */
+  unsigned long flushes;
+  unsigned long pages;
+  unsigned long requests;
+
+  /* Page addresses of the slots */
+  uint32_t tags[EEPROM_COMBINER_SLOTS];
+  uint8_t data[EEPROM_COMBINER_MAX];
+  uint8_t mask[EEPROM_COMBINER_MAX / 8];
+};
+
+struct EepromBenchmark
+{
+  struct Interface *memory;
+  struct Timer *timer;
+
+  /* Transfer buffer, its size is the length of the benchmark region */
+  uint8_t *buffer;
+  size_t size;
+
+  uint32_t position;
+  uint32_t page;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+bool eepromCombinerInit(struct EepromCombiner *, struct Interface *,
+    uint32_t, uint32_t);
+enum Result eepromCombinerFlush(struct EepromCombiner *);
+enum Result eepromCombinerWrite(struct EepromCombiner *, uint32_t,
+    const void *, size_t);
+
+bool eepromBenchmarkInit(struct EepromBenchmark *, struct Interface *,
+    struct Timer *, void *, size_t, uint32_t, uint32_t);
+uint32_t eepromBenchmarkPollTime(struct EepromBenchmark *, uint32_t);
+uint32_t eepromBenchmarkRandom(struct EepromBenchmark *,
+    struct EepromCombiner *, size_t, size_t);
+uint32_t eepromBenchmarkRead(struct EepromBenchmark *, size_t);
+uint32_t eepromBenchmarkWrite(struct EepromBenchmark *, size_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_EEPROM_HELPERS_H_ */
@@ -0,0 +1,690 @@
+/*
+ * helpers/flash_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "flash_helpers.h"
+#include <halm/generic/flash.h>
+#include <halm/timer.h>
+#include <halm/wq.h>
+#include <xcore/interface.h>
+#include <xcore/memory.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static enum Result benchmarkErase(struct FlashBenchmark *, enum FlashParameter,
+    uint32_t);
+static uint32_t benchmarkRandomOffset(const struct FlashBenchmark *,
+    uint32_t *, size_t);
+static uint32_t benchmarkReadLoads(struct FlashBenchmark *, const uint8_t *,
+    enum FlashMappedAccess, size_t);
+static uint32_t benchmarkRate(const struct FlashBenchmark *, uint32_t,
+    uint32_t);
+static enum Result benchmarkWait(struct FlashBenchmark *);
+static void onBenchmarkEvent(void *);
+
+static void pipelineFill(struct FlashPipeline *, uint8_t *, uint32_t);
+static void pipelineFinish(struct FlashPipeline *, enum Result);
+static enum Result pipelineIssue(struct FlashPipeline *,
+    enum FlashPipelineState);
+static void pipelineStepTask(void *);
+static bool pipelineVerify(const struct FlashPipeline *, const uint8_t *,
+    uint32_t);
+static void onPipelineEvent(void *);
+/*----------------------------------------------------------------------------*/
+static enum Result benchmarkErase(struct FlashBenchmark *benchmark,
+    enum FlashParameter command, uint32_t position)
+{
+  const enum Result res = ifSetParam(benchmark->memory, command, &position);
+
+  if (benchmark->zerocopy && (res == E_OK || res == E_BUSY))
+    return benchmarkWait(benchmark);
+  else
+    return res;
+}
+/*----------------------------------------------------------------------------*/
+/* Chunk-aligned offset inside the region from a linear congruential sequence */
+static uint32_t benchmarkRandomOffset(const struct FlashBenchmark *benchmark,
+    uint32_t *seed, size_t chunk)
+{
+  *seed = *seed * 1664525UL + 1013904223UL;
+  return (*seed >> 8) % (benchmark->length / chunk) * chunk;
+}
+/*----------------------------------------------------------------------------*/
+/* Convert the number of bytes processed in a time interval to KiB/s */
+static uint32_t benchmarkRate(const struct FlashBenchmark *benchmark,
+    uint32_t length, uint32_t ticks)
+{
+  const uint64_t frequency = timerGetFrequency(benchmark->timer);
+
+  if (!ticks)
+    ticks = 1;
+
+  return (uint32_t)(((uint64_t)length * frequency) / ((uint64_t)ticks * 1024));
+}
+/*----------------------------------------------------------------------------*/
+static enum Result benchmarkWait(struct FlashBenchmark *benchmark)
+{
+  while (!benchmark->event)
+    barrier();
+  benchmark->event = false;
+
+  return ifGetParam(benchmark->memory, IF_STATUS, NULL);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t benchmarkReadLoads(struct FlashBenchmark *benchmark,
+    const uint8_t *source, enum FlashMappedAccess access, size_t chunk)
+{
+  uint32_t checksum = 0;
+
+  /* Volatile pointers keep the compiler from merging or removing loads */
+  if (access == FLASH_MAPPED_BYTE)
+  {
+    const volatile uint8_t * const bytes = source;
+
+    for (size_t i = 0; i < chunk; ++i)
+      checksum += bytes[i];
+  }
+  else if (access == FLASH_MAPPED_WORD)
+  {
+    const volatile uint32_t * const words = (const volatile uint32_t *)source;
+
+    for (size_t i = 0; i < chunk / sizeof(uint32_t); ++i)
+      checksum += words[i];
+  }
+  else
+  {
+    memcpy(benchmark->buffer, source, chunk);
+  }
+
+  return checksum;
+}
+/*----------------------------------------------------------------------------*/
+static void onBenchmarkEvent(void *argument)
+{
+  struct FlashBenchmark * const benchmark = argument;
+  benchmark->event = true;
+}
+/*----------------------------------------------------------------------------*/
+static inline uint8_t pipelinePattern(uint32_t address, uint8_t seed)
+{
+  return (uint8_t)(address ^ (address >> 8) ^ seed);
+}
+/*----------------------------------------------------------------------------*/
+static void pipelineFill(struct FlashPipeline *pipeline, uint8_t *buffer,
+    uint32_t offset)
+{
+  const uint32_t address = pipeline->position + offset;
+
+  for (size_t i = 0; i < pipeline->chunk; ++i)
+    buffer[i] = pipelinePattern(address + i, pipeline->seed);
+}
+/*----------------------------------------------------------------------------*/
+static void pipelineFinish(struct FlashPipeline *pipeline, enum Result res)
+{
+  pipeline->elapsed = timerGetValue(pipeline->timer) - pipeline->started;
+  pipeline->result = res;
+  pipeline->state = FLASH_PIPELINE_IDLE;
+
+  ifSetCallback(pipeline->memory, NULL, NULL);
+  ifSetParam(pipeline->memory, IF_BLOCKING, NULL);
+
+  if (pipeline->callback != NULL)
+    pipeline->callback(pipeline->argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result pipelineIssue(struct FlashPipeline *pipeline,
+    enum FlashPipelineState state)
+{
+  const uint32_t position = pipeline->position + pipeline->offset
+      + pipeline->index * pipeline->chunk;
+  uint8_t * const buffer = pipeline->buffers[pipeline->index & 1];
+  enum Result res;
+
+  pipeline->state = state;
+
+  switch (state)
+  {
+    case FLASH_PIPELINE_ERASE:
+      res = ifSetParam(pipeline->memory, pipeline->sector < pipeline->length ?
+          IF_FLASH_ERASE_SECTOR : IF_FLASH_ERASE_BLOCK, &position);
+      return res == E_BUSY ? E_OK : res;
+
+    case FLASH_PIPELINE_PROGRAM:
+      res = ifSetParam(pipeline->memory, IF_POSITION, &position);
+      if (res == E_OK
+          && ifWrite(pipeline->memory, buffer, pipeline->chunk)
+              != pipeline->chunk)
+      {
+        res = E_INTERFACE;
+      }
+      return res;
+
+    case FLASH_PIPELINE_READ:
+      res = ifSetParam(pipeline->memory, IF_POSITION, &position);
+      if (res == E_OK
+          && ifRead(pipeline->memory, buffer, pipeline->chunk)
+              != pipeline->chunk)
+      {
+        res = E_INTERFACE;
+      }
+      return res;
+
+    default:
+      return E_ERROR;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void pipelineStepTask(void *argument)
+{
+  struct FlashPipeline * const pipeline = argument;
+  const uint32_t chunks = pipeline->sector / pipeline->chunk;
+  const uint32_t index = pipeline->index;
+  enum Result res;
+
+  if (pipeline->state == FLASH_PIPELINE_IDLE)
+    return;
+
+  res = ifGetParam(pipeline->memory, IF_STATUS, NULL);
+  if (res == E_OK)
+    res = pipeline->result;
+  if (res != E_OK)
+  {
+    pipelineFinish(pipeline, res);
+    return;
+  }
+
+  switch (pipeline->state)
+  {
+    case FLASH_PIPELINE_ERASE:
+      /* The first chunk was prepared while the sector was being erased */
+      pipeline->programmed = timerGetValue(pipeline->timer);
+      res = pipelineIssue(pipeline, FLASH_PIPELINE_PROGRAM);
+
+      if (res == E_OK && chunks > 1)
+      {
+        pipelineFill(pipeline, pipeline->buffers[1],
+            pipeline->offset + pipeline->chunk);
+      }
+      break;
+
+    case FLASH_PIPELINE_PROGRAM:
+      if (index + 1 < chunks)
+      {
+        /* Fill the next buffer while the current one is being programmed */
+        ++pipeline->index;
+        res = pipelineIssue(pipeline, FLASH_PIPELINE_PROGRAM);
+
+        if (res == E_OK && index + 2 < chunks)
+        {
+          pipelineFill(pipeline, pipeline->buffers[index & 1],
+              pipeline->offset + (index + 2) * pipeline->chunk);
+        }
+      }
+      else
+      {
+        pipeline->program +=
+            timerGetValue(pipeline->timer) - pipeline->programmed;
+        pipeline->index = 0;
+        res = pipelineIssue(pipeline, FLASH_PIPELINE_READ);
+      }
+      break;
+
+    case FLASH_PIPELINE_READ:
+    {
+      /* Position and buffer of the chunk that was just read */
+      const uint32_t offset = pipeline->offset + index * pipeline->chunk;
+      const uint8_t * const buffer = pipeline->buffers[index & 1];
+
+      if (index + 1 < chunks)
+      {
+        ++pipeline->index;
+        res = pipelineIssue(pipeline, FLASH_PIPELINE_READ);
+      }
+      else
+      {
+        pipeline->offset += pipeline->sector;
+        pipeline->index = 0;
+
+        if (pipeline->offset < pipeline->length)
+          res = pipelineIssue(pipeline, FLASH_PIPELINE_ERASE);
+        else
+          pipeline->state = FLASH_PIPELINE_IDLE;
+      }
+
+      /* Verify the chunk while the next operation is in flight */
+      if (res == E_OK && !pipelineVerify(pipeline, buffer, offset))
+      {
+        if (pipeline->state != FLASH_PIPELINE_IDLE)
+        {
+          /* Run will be finished after the completion of the operation */
+          pipeline->result = E_VALUE;
+          return;
+        }
+
+        res = E_VALUE;
+      }
+
+      /* Prepare the first chunk of the next sector during the erase */
+      if (res == E_OK && pipeline->state == FLASH_PIPELINE_ERASE)
+        pipelineFill(pipeline, pipeline->buffers[0], pipeline->offset);
+      break;
+    }
+
+    default:
+      res = E_ERROR;
+      break;
+  }
+
+  if (res != E_OK || pipeline->state == FLASH_PIPELINE_IDLE)
+    pipelineFinish(pipeline, res);
+}
+/*----------------------------------------------------------------------------*/
+static bool pipelineVerify(const struct FlashPipeline *pipeline,
+    const uint8_t *buffer, uint32_t offset)
+{
+  const uint32_t address = pipeline->position + offset;
+
+  for (size_t i = 0; i < pipeline->chunk; ++i)
+  {
+    if (buffer[i] != pipelinePattern(address + i, pipeline->seed))
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void onPipelineEvent(void *argument)
+{
+  struct FlashPipeline * const pipeline = argument;
+  wqAdd(pipeline->wq, pipelineStepTask, pipeline);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a benchmark object.
+ * @param benchmark Pointer to a benchmark object.
+ * @param memory Flash memory interface.
+ * @param timer Free-running timer used for time measurements.
+ * @param buffer Transfer buffer.
+ * @param size Size of the transfer buffer.
+ * @param position Start of the region, the region will be erased.
+ * @return @b true on success or @b false when geometry is not available.
+ */
+bool flashBenchmarkInit(struct FlashBenchmark *benchmark,
+    struct Interface *memory, struct Timer *timer, void *buffer, size_t size,
+    uint32_t position)
+{
+  uint32_t block = 0;
+  uint32_t capacity = 0;
+  uint32_t sector = 0;
+
+  if (ifGetParam(memory, IF_SIZE, &capacity) != E_OK)
+    return false;
+  if (ifGetParam(memory, IF_FLASH_BLOCK_SIZE, &block) != E_OK || !block)
+    return false;
+  if (ifGetParam(memory, IF_FLASH_SECTOR_SIZE, &sector) != E_OK)
+    sector = 0;
+
+  /* Align the region to the block boundary */
+  position -= position % block;
+  if (position + block > capacity)
+    return false;
+
+  benchmark->memory = memory;
+  benchmark->timer = timer;
+  benchmark->buffer = buffer;
+  benchmark->size = size;
+  benchmark->position = position;
+  benchmark->length = block;
+  benchmark->sector = sector;
+  benchmark->mapping = NULL;
+  benchmark->mappingArgument = NULL;
+  benchmark->window = NULL;
+  benchmark->checksum = 0;
+  benchmark->event = false;
+  benchmark->zerocopy = false;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Configure memory-mapped reads.
+ * @param benchmark Pointer to a benchmark object.
+ * @param window Start of the memory-mapped window of the whole memory.
+ * @param mapping Function that enables or disables memory mapping.
+ * @param argument Argument for the mapping function.
+ */
+void flashBenchmarkSetMapping(struct FlashBenchmark *benchmark,
+    const void *window, void (*mapping)(void *, bool), void *argument)
+{
+  benchmark->window = window;
+  benchmark->mapping = mapping;
+  benchmark->mappingArgument = argument;
+}
+/*----------------------------------------------------------------------------*/
+bool flashBenchmarkSetZeroCopy(struct FlashBenchmark *benchmark, bool state)
+{
+  if (state)
+  {
+    if (ifSetParam(benchmark->memory, IF_ZEROCOPY, NULL) != E_OK)
+      return false;
+    ifSetCallback(benchmark->memory, onBenchmarkEvent, benchmark);
+  }
+  else
+  {
+    ifSetCallback(benchmark->memory, NULL, NULL);
+    ifSetParam(benchmark->memory, IF_BLOCKING, NULL);
+  }
+
+  benchmark->event = false;
+  benchmark->zerocopy = state;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Erase the whole region and measure erase bandwidth.
+ * @param benchmark Pointer to a benchmark object.
+ * @param sectors Erase the region sector by sector instead of a block erase.
+ * @return Bandwidth in KiB/s or zero on failure.
+ */
+uint32_t flashBenchmarkErase(struct FlashBenchmark *benchmark, bool sectors)
+{
+  if (sectors && !benchmark->sector)
+    return 0;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  if (sectors)
+  {
+    for (uint32_t offset = 0; offset < benchmark->length;
+        offset += benchmark->sector)
+    {
+      if (benchmarkErase(benchmark, IF_FLASH_ERASE_SECTOR,
+          benchmark->position + offset) != E_OK)
+      {
+        return 0;
+      }
+    }
+  }
+  else
+  {
+    if (benchmarkErase(benchmark, IF_FLASH_ERASE_BLOCK,
+        benchmark->position) != E_OK)
+    {
+      return 0;
+    }
+  }
+
+  return benchmarkRate(benchmark, benchmark->length,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Erase the region and program it with chunks of the specified length.
+ * @param benchmark Pointer to a benchmark object.
+ * @param chunk Length of a single write request.
+ * @return Bandwidth in KiB/s or zero on failure, erase time is not included.
+ */
+uint32_t flashBenchmarkProgram(struct FlashBenchmark *benchmark, size_t chunk)
+{
+  if (chunk > benchmark->size || benchmark->length % chunk)
+    return 0;
+  if (!flashBenchmarkErase(benchmark, false))
+    return 0;
+
+  for (size_t i = 0; i < chunk; ++i)
+    benchmark->buffer[i] = (uint8_t)i;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t offset = 0; offset < benchmark->length; offset += chunk)
+  {
+    const uint32_t position = benchmark->position + offset;
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifWrite(benchmark->memory, benchmark->buffer, chunk) != chunk)
+      return 0;
+    if (benchmark->zerocopy && benchmarkWait(benchmark) != E_OK)
+      return 0;
+  }
+
+  return benchmarkRate(benchmark, benchmark->length,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Read the region with chunks of the specified length.
+ * @param benchmark Pointer to a benchmark object.
+ * @param chunk Length of a single read request.
+ * @return Bandwidth in KiB/s or zero on failure.
+ */
+uint32_t flashBenchmarkRead(struct FlashBenchmark *benchmark, size_t chunk)
+{
+  if (chunk > benchmark->size || benchmark->length % chunk)
+    return 0;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t offset = 0; offset < benchmark->length; offset += chunk)
+  {
+    const uint32_t position = benchmark->position + offset;
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifRead(benchmark->memory, benchmark->buffer, chunk) != chunk)
+      return 0;
+    if (benchmark->zerocopy && benchmarkWait(benchmark) != E_OK)
+      return 0;
+  }
+
+  return benchmarkRate(benchmark, benchmark->length,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Read the region through the memory-mapped window.
+ * @param benchmark Pointer to a benchmark object.
+ * @param access Access pattern.
+ * @param chunk Length of a single read operation, pseudo-random positions
+ * are aligned to the chunk length.
+ * @param persistent Keep memory mapping enabled during the whole run,
+ * otherwise mapping is enabled and disabled around each chunk.
+ * @return Bandwidth in KiB/s or zero on failure.
+ */
+uint32_t flashBenchmarkReadMapped(struct FlashBenchmark *benchmark,
+    enum FlashMappedAccess access, size_t chunk, bool persistent)
+{
+  if (benchmark->window == NULL || benchmark->mapping == NULL)
+    return 0;
+  if (chunk > benchmark->size || benchmark->length % chunk
+      || chunk % sizeof(uint32_t))
+  {
+    return 0;
+  }
+
+  const uint8_t * const source = benchmark->window + benchmark->position;
+  uint32_t checksum = 0;
+  uint32_t seed = 0;
+
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  if (persistent)
+    benchmark->mapping(benchmark->mappingArgument, true);
+
+  for (uint32_t offset = 0; offset < benchmark->length; offset += chunk)
+  {
+    const uint32_t address = access == FLASH_MAPPED_RANDOM ?
+        benchmarkRandomOffset(benchmark, &seed, chunk) : offset;
+
+    if (!persistent)
+      benchmark->mapping(benchmark->mappingArgument, true);
+
+    checksum += benchmarkReadLoads(benchmark, source + address, access, chunk);
+
+    if (!persistent)
+      benchmark->mapping(benchmark->mappingArgument, false);
+  }
+
+  if (persistent)
+    benchmark->mapping(benchmark->mappingArgument, false);
+
+  const uint32_t elapsed = timerGetValue(benchmark->timer) - start;
+
+  benchmark->checksum = checksum;
+  return benchmarkRate(benchmark, benchmark->length, elapsed);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Read chunks at pseudo-random positions using memory commands. Positions
+ * are the same as in memory-mapped random reads.
+ * @param benchmark Pointer to a benchmark object.
+ * @param chunk Length of a single read request.
+ * @return Bandwidth in KiB/s or zero on failure.
+ */
+uint32_t flashBenchmarkReadRandom(struct FlashBenchmark *benchmark,
+    size_t chunk)
+{
+  if (chunk > benchmark->size || benchmark->length % chunk)
+    return 0;
+
+  uint32_t seed = 0;
+  const uint32_t start = timerGetValue(benchmark->timer);
+
+  for (uint32_t offset = 0; offset < benchmark->length; offset += chunk)
+  {
+    const uint32_t position = benchmark->position
+        + benchmarkRandomOffset(benchmark, &seed, chunk);
+
+    if (ifSetParam(benchmark->memory, IF_POSITION, &position) != E_OK)
+      return 0;
+    if (ifRead(benchmark->memory, benchmark->buffer, chunk) != chunk)
+      return 0;
+    if (benchmark->zerocopy && benchmarkWait(benchmark) != E_OK)
+      return 0;
+  }
+
+  return benchmarkRate(benchmark, benchmark->length,
+      timerGetValue(benchmark->timer) - start);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a pipelined test object.
+ * @param pipeline Pointer to a pipeline object.
+ * @param memory Flash memory interface with zero-copy support.
+ * @param timer Free-running timer used for time measurements.
+ * @param wq Work queue for the state machine.
+ * @param buffer Buffer, it will be split into two equal parts.
+ * @param size Size of the buffer, should be a multiple of the page size.
+ * @return @b true on success.
+ */
+bool flashPipelineInit(struct FlashPipeline *pipeline,
+    struct Interface *memory, struct Timer *timer, struct WorkQueue *wq,
+    void *buffer, size_t size)
+{
+  if (size < 2)
+    return false;
+
+  pipeline->memory = memory;
+  pipeline->timer = timer;
+  pipeline->wq = wq;
+  pipeline->callback = NULL;
+  pipeline->argument = NULL;
+  pipeline->buffers[0] = buffer;
+  pipeline->buffers[1] = (uint8_t *)buffer + size / 2;
+  pipeline->chunk = size / 2;
+  pipeline->seed = 0;
+  pipeline->elapsed = 0;
+  pipeline->program = 0;
+  pipeline->result = E_OK;
+  pipeline->state = FLASH_PIPELINE_IDLE;
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/* Program throughput of the last run in KiB/s, erase time is not included */
+uint32_t flashPipelineGetProgramRate(const struct FlashPipeline *pipeline)
+{
+  const uint64_t frequency = timerGetFrequency(pipeline->timer);
+  const uint64_t ticks = pipeline->program ? pipeline->program : 1;
+
+  return (uint32_t)(((uint64_t)pipeline->length * frequency) / (ticks * 1024));
+}
+/*----------------------------------------------------------------------------*/
+/* Sustained throughput of the last run in KiB/s, including erase and verify */
+uint32_t flashPipelineGetTotalRate(const struct FlashPipeline *pipeline)
+{
+  const uint64_t frequency = timerGetFrequency(pipeline->timer);
+  const uint64_t ticks = pipeline->elapsed ? pipeline->elapsed : 1;
+
+  return (uint32_t)(((uint64_t)pipeline->length * frequency) / (ticks * 1024));
+}
+/*----------------------------------------------------------------------------*/
+bool flashPipelineIsBusy(const struct FlashPipeline *pipeline)
+{
+  return pipeline->state != FLASH_PIPELINE_IDLE;
+}
+/*----------------------------------------------------------------------------*/
+void flashPipelineSetCallback(struct FlashPipeline *pipeline,
+    void (*callback)(void *), void *argument)
+{
+  pipeline->callback = callback;
+  pipeline->argument = argument;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Start erasing, programming and verifying the region sector by sector.
+ * The function returns immediately, the completion callback is called
+ * from the work queue when the run is finished.
+ * @param pipeline Pointer to a pipeline object.
+ * @param position Start of the region, aligned to the block boundary.
+ * @param length Length of the region, a multiple of the sector size.
+ * @return @b E_OK when the run was started successfully.
+ */
+enum Result flashPipelineStart(struct FlashPipeline *pipeline,
+    uint32_t position, uint32_t length)
+{
+  uint32_t sector = 0;
+  enum Result res;
+
+  if (pipeline->state != FLASH_PIPELINE_IDLE)
+    return E_BUSY;
+
+  res = ifGetParam(pipeline->memory, IF_FLASH_SECTOR_SIZE, &sector);
+  if (res != E_OK || !sector)
+    sector = length;
+  if (sector % pipeline->chunk || length % sector)
+    return E_VALUE;
+
+  res = ifSetParam(pipeline->memory, IF_ZEROCOPY, NULL);
+  if (res != E_OK)
+    return res;
+  ifSetCallback(pipeline->memory, onPipelineEvent, pipeline);
+
+  pipeline->position = position;
+  pipeline->length = length;
+  pipeline->sector = sector;
+  pipeline->offset = 0;
+  pipeline->index = 0;
+  pipeline->program = 0;
+  pipeline->elapsed = 0;
+  pipeline->result = E_OK;
+  ++pipeline->seed;
+
+  pipeline->started = timerGetValue(pipeline->timer);
+
+  res = pipelineIssue(pipeline, FLASH_PIPELINE_ERASE);
+  if (res == E_OK)
+  {
+    /* Prepare the first chunk while the first sector is being erased */
+    pipelineFill(pipeline, pipeline->buffers[0], 0);
+  }
+  else
+  {
+    pipeline->state = FLASH_PIPELINE_IDLE;
+    ifSetCallback(pipeline->memory, NULL, NULL);
+    ifSetParam(pipeline->memory, IF_BLOCKING, NULL);
+  }
+
+  return res;
+}
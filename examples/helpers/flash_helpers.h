@@ -0,0 +1,131 @@
+/*
+ * helpers/flash_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_FLASH_HELPERS_H_
+#define HELPERS_FLASH_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+struct Interface;
+struct Timer;
+struct WorkQueue;
+
+enum [[gnu::packed]] FlashMappedAccess
+{
+  /* Sequential 8-bit loads */
+  FLASH_MAPPED_BYTE,
+  /* Sequential 32-bit loads */
+  FLASH_MAPPED_WORD,
+  /* Sequential copying of chunks */
+  FLASH_MAPPED_COPY,
+  /* Copying of chunks from pseudo-random positions */
+  FLASH_MAPPED_RANDOM
+};
+
+enum [[gnu::packed]] FlashPipelineState
+{
+  FLASH_PIPELINE_IDLE,
+  FLASH_PIPELINE_ERASE,
+  FLASH_PIPELINE_PROGRAM,
+  FLASH_PIPELINE_READ
+};
+
+struct FlashBenchmark
+{
+  struct Interface *memory;
+  struct Timer *timer;
+
+  /* Transfer buffer, its size limits the chunk length */
+  uint8_t *buffer;
+  size_t size;
+
+  /* Benchmark region, exactly one erase block */
+  uint32_t position;
+  uint32_t length;
+  /* Sector size or zero when sector erase is not available */
+  uint32_t sector;
+
+  /* Memory mapping control, mapped reads are disabled when it is not set */
+  void (*mapping)(void *, bool);
+  void *mappingArgument;
+  const uint8_t *window;
+  /* Sum of the loaded values, keeps loads from being optimized out */
+  uint32_t checksum;
+
+  /* Completion flag for zero-copy operations */
+  volatile bool event;
+  bool zerocopy;
+};
+
+struct FlashPipeline
+{
+  struct Interface *memory;
+  struct Timer *timer;
+  struct WorkQueue *wq;
+
+  /* Completion callback, called from the work queue */
+  void (*callback)(void *);
+  void *argument;
+
+  /* Two buffers: one is transferred while the other one is processed */
+  uint8_t *buffers[2];
+  /* Length of a single program or read request */
+  size_t chunk;
+
+  /* Region under test */
+  uint32_t position;
+  uint32_t length;
+  uint32_t sector;
+
+  /* Offset of the current sector relative to the start of the region */
+  uint32_t offset;
+  /* Index of the chunk in flight */
+  uint32_t index;
+  /* Seed of the test pattern, changed on each run */
+  uint8_t seed;
+
+  /* Start of the run and start of the current program phase */
+  uint32_t started;
+  uint32_t programmed;
+  /* Total duration of the run and of the program phases in timer ticks */
+  uint32_t elapsed;
+  uint32_t program;
+
+  enum Result result;
+  enum FlashPipelineState state;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+bool flashBenchmarkInit(struct FlashBenchmark *, struct Interface *,
+    struct Timer *, void *, size_t, uint32_t);
+void flashBenchmarkSetMapping(struct FlashBenchmark *, const void *,
+    void (*)(void *, bool), void *);
+bool flashBenchmarkSetZeroCopy(struct FlashBenchmark *, bool);
+
+uint32_t flashBenchmarkErase(struct FlashBenchmark *, bool);
+uint32_t flashBenchmarkProgram(struct FlashBenchmark *, size_t);
+uint32_t flashBenchmarkRead(struct FlashBenchmark *, size_t);
+uint32_t flashBenchmarkReadMapped(struct FlashBenchmark *,
+    enum FlashMappedAccess, size_t, bool);
+uint32_t flashBenchmarkReadRandom(struct FlashBenchmark *, size_t);
+
+bool flashPipelineInit(struct FlashPipeline *, struct Interface *,
+    struct Timer *, struct WorkQueue *, void *, size_t);
+uint32_t flashPipelineGetProgramRate(const struct FlashPipeline *);
+uint32_t flashPipelineGetTotalRate(const struct FlashPipeline *);
+bool flashPipelineIsBusy(const struct FlashPipeline *);
+void flashPipelineSetCallback(struct FlashPipeline *, void (*)(void *),
+    void *);
+enum Result flashPipelineStart(struct FlashPipeline *, uint32_t, uint32_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_FLASH_HELPERS_H_ */
@@ -0,0 +1,490 @@
+/*
+ * helpers/led_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "led_helpers.h"
+#include <xcore/interface.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Reset period of 300 us at the symbol rate of the parallel bus */
+#define WS281X_RESET_SYMBOLS  720
+/* Symbols for each data bit: high level, data and low level */
+#define WS281X_BIT_SYMBOLS    3
+/*----------------------------------------------------------------------------*/
+static void engineMarkAll(struct LedEngine *);
+static void engineRelease(struct LedEngine *, size_t);
+static void engineRender(struct LedEngine *, uint8_t);
+static void onChainEvent(void *);
+
+static enum Result parallelInit(void *, const void *);
+static void parallelDeinit(void *);
+static void parallelSetCallback(void *, void (*)(void *), void *);
+static enum Result parallelGetParam(void *, int, void *);
+static enum Result parallelSetParam(void *, int, const void *);
+static size_t parallelRead(void *, void *, size_t);
+static size_t parallelWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const WS281xParallel =
+    &(const struct InterfaceClass){
+    .size = sizeof(struct WS281xParallel),
+    .init = parallelInit,
+    .deinit = parallelDeinit,
+
+    .setCallback = parallelSetCallback,
+    .getParam = parallelGetParam,
+    .setParam = parallelSetParam,
+    .read = parallelRead,
+    .write = parallelWrite
+};
+/*----------------------------------------------------------------------------*/
+/* Gamma correction with the exponent 2.2 */
+static const uint8_t gammaTable[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3,
+    3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6,
+    6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10,
+    11, 11, 11, 12, 12, 13, 13, 13, 14, 14, 15, 15,
+    16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 22,
+    22, 23, 23, 24, 25, 25, 26, 26, 27, 28, 28, 29,
+    30, 30, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38,
+    39, 39, 40, 41, 42, 43, 43, 44, 45, 46, 47, 48,
+    49, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59,
+    60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+    73, 74, 75, 76, 77, 78, 79, 81, 82, 83, 84, 85,
+    87, 88, 89, 90, 91, 93, 94, 95, 97, 98, 99, 100,
+    102, 103, 105, 106, 107, 109, 110, 111, 113, 114, 116, 117,
+    119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154,
+    156, 158, 159, 161, 163, 165, 166, 168, 170, 172, 173, 175,
+    177, 179, 181, 182, 184, 186, 188, 190, 192, 194, 196, 197,
+    199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246,
+    248, 251, 253, 255
+};
+/*----------------------------------------------------------------------------*/
+static void engineMarkAll(struct LedEngine *engine)
+{
+  const size_t words = engine->length / 32;
+  const size_t rest = engine->length % 32;
+
+  for (size_t buffer = 0; buffer < ARRAY_SIZE(engine->dirty); ++buffer)
+  {
+    memset(engine->dirty[buffer], 0xFF, words * sizeof(uint32_t));
+
+    if (rest)
+      engine->dirty[buffer][words] = (1UL << rest) - 1;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void engineRelease(struct LedEngine *engine, size_t count)
+{
+  /* Chain events may arrive while the frame is still being started */
+  if (__atomic_sub_fetch(&engine->active, count, __ATOMIC_ACQ_REL) == 0)
+  {
+    ++engine->transmitted;
+
+    if (engine->callback != NULL)
+      engine->callback(engine->callbackArgument);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void engineRender(struct LedEngine *engine, uint8_t buffer)
+{
+  const size_t words = (engine->length + 31) / 32;
+  uint32_t * const dirty = engine->dirty[buffer];
+  uint8_t * const frame = engine->frames[buffer];
+
+  /* Unchanged LEDs are skipped 32 at a time */
+  for (size_t word = 0; word < words; ++word)
+  {
+    uint32_t mask = dirty[word];
+
+    if (!mask)
+      continue;
+    dirty[word] = 0;
+
+    while (mask)
+    {
+      const size_t index = word * 32 + (size_t)__builtin_ctz(mask);
+      const uint8_t * const color = engine->colors + index * 3;
+      uint8_t * const output = frame + index * 3;
+
+      output[0] = engine->table[color[1]];
+      output[1] = engine->table[color[0]];
+      output[2] = engine->table[color[2]];
+
+      mask &= mask - 1;
+      ++engine->encoded;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void onChainEvent(void *argument)
+{
+  engineRelease(argument, 1);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result parallelInit(void *object, const void *configBase)
+{
+  const struct WS281xParallelConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->bus != NULL && config->size > 0);
+
+  struct WS281xParallel * const interface = object;
+  const size_t symbols = config->size * 24 * WS281X_BIT_SYMBOLS;
+
+  interface->length = symbols + WS281X_RESET_SYMBOLS;
+  interface->buffer = malloc(interface->length);
+  if (interface->buffer == NULL)
+    return E_MEMORY;
+
+  interface->bus = config->bus;
+  interface->size = config->size;
+
+  /* Only data symbols are changed, other symbols are constant */
+  for (size_t i = 0; i < symbols; i += WS281X_BIT_SYMBOLS)
+  {
+    interface->buffer[i + 0] = 0xFF;
+    interface->buffer[i + 1] = 0x00;
+    interface->buffer[i + 2] = 0x00;
+  }
+  memset(interface->buffer + symbols, 0, WS281X_RESET_SYMBOLS);
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void parallelDeinit(void *object)
+{
+  struct WS281xParallel * const interface = object;
+
+  /* Bus is owned by the output */
+  deinit(interface->bus);
+  free(interface->buffer);
+}
+/*----------------------------------------------------------------------------*/
+static void parallelSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct WS281xParallel * const interface = object;
+  ifSetCallback(interface->bus, callback, argument);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result parallelGetParam(void *object, int parameter, void *data)
+{
+  struct WS281xParallel * const interface = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_STATUS:
+      return ifGetParam(interface->bus, parameter, data);
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result parallelSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct WS281xParallel * const interface = object;
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_BLOCKING:
+    case IF_ZEROCOPY:
+      return ifSetParam(interface->bus, parameter, data);
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t parallelRead(void *, void *, size_t)
+{
+  return 0;
+}
+/*----------------------------------------------------------------------------*/
+static size_t parallelWrite(void *object, const void *buffer, size_t length)
+{
+  struct WS281xParallel * const interface = object;
+  const size_t stride = interface->size * 3;
+
+  /* Frame contains colors of all lanes, one lane after another */
+  if (length != stride * WS281X_PARALLEL_LANES)
+    return 0;
+
+  const uint8_t *input = buffer;
+  uint8_t *output = interface->buffer + 1;
+
+  for (size_t i = 0; i < stride; ++i)
+  {
+    ws281xTranspose(output, WS281X_BIT_SYMBOLS, input++, stride);
+    output += 8 * WS281X_BIT_SYMBOLS;
+  }
+
+  if (ifWrite(interface->bus, interface->buffer, interface->length)
+      != interface->length)
+  {
+    return 0;
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a chain of LEDs.
+ * @param chain Pointer to a chain object.
+ * @param output Output interface with zero-copy mode support.
+ * @param count Number of LEDs in the chain.
+ */
+void ledChainInit(struct LedChain *chain, struct Interface *output,
+    size_t count)
+{
+  chain->output = output;
+  chain->first = 0;
+  chain->count = count;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize an LED engine. LEDs of all chains are numbered sequentially,
+ * outputs of the chains are switched to zero-copy mode.
+ * @param engine Pointer to an engine object.
+ * @param chains Array of initialized chains.
+ * @param count Number of chains.
+ * @param memory Memory for colors and frame buffers, aligned to a 32-bit word.
+ * @param size Size of the memory, see LED_ENGINE_MEMORY_SIZE.
+ * @return Initialization is successful.
+ */
+bool ledEngineInit(struct LedEngine *engine, struct LedChain *chains,
+    size_t count, void *memory, size_t size)
+{
+  size_t length = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    chains[i].first = length;
+    length += chains[i].count;
+  }
+
+  assert(((uintptr_t)memory & 3) == 0);
+  if (!length || size < LED_ENGINE_MEMORY_SIZE(length))
+    return false;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (ifSetParam(chains[i].output, IF_ZEROCOPY, NULL) != E_OK)
+      return false;
+    ifSetCallback(chains[i].output, onChainEvent, engine);
+  }
+
+  const size_t words = (length + 31) / 32;
+
+  engine->chains = chains;
+  engine->count = count;
+  engine->length = length;
+
+  engine->callback = NULL;
+  engine->callbackArgument = NULL;
+
+  engine->dirty[0] = memory;
+  engine->dirty[1] = engine->dirty[0] + words;
+  engine->colors = (uint8_t *)(engine->dirty[1] + words);
+  engine->frames[0] = engine->colors + length * 3;
+  engine->frames[1] = engine->frames[0] + length * 3;
+
+  engine->back = 0;
+  engine->encoded = 0;
+  engine->transmitted = 0;
+  engine->active = 0;
+
+  memset(engine->colors, 0, length * 3);
+  ledEngineSetBrightness(engine, 255);
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Set the same color for all LEDs.
+ * @param engine Pointer to an engine object.
+ * @param color Color in 0xRRGGBB format.
+ */
+void ledEngineFill(struct LedEngine *engine, uint32_t color)
+{
+  for (size_t i = 0; i < engine->length; ++i)
+    ledEngineSetColor(engine, i, color);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Check whether the transmission of the last frame is in progress.
+ * @param engine Pointer to an engine object.
+ * @return Frame transmission is in progress.
+ */
+bool ledEngineIsBusy(const struct LedEngine *engine)
+{
+  return engine->active > 0;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Encode LEDs changed since the last update into the back frame buffer.
+ * The function may be called while the previous frame is being transmitted,
+ * the rest of the changes is encoded by the update function.
+ * @param engine Pointer to an engine object.
+ */
+void ledEngineRender(struct LedEngine *engine)
+{
+  engineRender(engine, engine->back);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Set global brightness, all LEDs are encoded again on the next update.
+ * @param engine Pointer to an engine object.
+ * @param brightness Brightness from 0 to 255.
+ */
+void ledEngineSetBrightness(struct LedEngine *engine, uint8_t brightness)
+{
+  for (size_t i = 0; i < ARRAY_SIZE(engine->table); ++i)
+    engine->table[i] = (uint8_t)((gammaTable[i] * brightness + 127) / 255);
+
+  engine->brightness = brightness;
+  engineMarkAll(engine);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Set the function called when all chains finish the frame transmission.
+ * The function is called from the interrupt context of the outputs or from
+ * ledEngineUpdate when all transfers finish before the frame is started.
+ * @param engine Pointer to an engine object.
+ * @param callback Callback function.
+ * @param argument Callback argument.
+ */
+void ledEngineSetCallback(struct LedEngine *engine, void (*callback)(void *),
+    void *argument)
+{
+  engine->callbackArgument = argument;
+  engine->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Set the color of an LED.
+ * @param engine Pointer to an engine object.
+ * @param index Position of the LED.
+ * @param color Color in 0xRRGGBB format.
+ */
+void ledEngineSetColor(struct LedEngine *engine, size_t index, uint32_t color)
+{
+  assert(index < engine->length);
+
+  uint8_t * const entry = engine->colors + index * 3;
+  const uint8_t red = (uint8_t)(color >> 16);
+  const uint8_t green = (uint8_t)(color >> 8);
+  const uint8_t blue = (uint8_t)color;
+
+  if (entry[0] == red && entry[1] == green && entry[2] == blue)
+    return;
+
+  entry[0] = red;
+  entry[1] = green;
+  entry[2] = blue;
+
+  /* Both frame buffers hold an outdated color of the LED */
+  engine->dirty[0][index / 32] |= 1UL << (index % 32);
+  engine->dirty[1][index / 32] |= 1UL << (index % 32);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Encode the remaining changes and start the transmission of the frame.
+ * Frame buffers are swapped after the start, so that the next frame
+ * is rendered while the current one is being transmitted. Chains whose
+ * outputs reject the frame are skipped.
+ * @param engine Pointer to an engine object.
+ * @return Transmission is started, false when the previous frame
+ * is still being transmitted or when all outputs rejected the frame.
+ */
+bool ledEngineUpdate(struct LedEngine *engine)
+{
+  if (engine->active)
+    return false;
+
+  const uint8_t * const frame = engine->frames[engine->back];
+  size_t rejected = 0;
+
+  engineRender(engine, engine->back);
+
+  /* Extra reference delays the completion until all chains are started */
+  engine->active = engine->count + 1;
+
+  for (size_t i = 0; i < engine->count; ++i)
+  {
+    const struct LedChain * const chain = &engine->chains[i];
+    const size_t length = chain->count * 3;
+
+    if (ifWrite(chain->output, frame + chain->first * 3, length) != length)
+      ++rejected;
+  }
+
+  if (rejected == engine->count)
+  {
+    /* No transfers are in progress, the frame will be sent again */
+    engine->active = 0;
+    return false;
+  }
+
+  engine->back ^= 1;
+
+  /* Release references of rejected chains and the extra reference */
+  engineRelease(engine, rejected + 1);
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Transpose an 8x8 bit matrix of the parallel output. Bit N of the output
+ * byte K is bit 7 - K of the input byte N, so that output bytes hold
+ * bits of all lanes starting from the most significant one.
+ * @param output Output buffer for 8 bytes.
+ * @param outputStride Distance between output bytes.
+ * @param input Input buffer with a byte for each lane.
+ * @param inputStride Distance between input bytes.
+ */
+void ws281xTranspose(uint8_t *output, size_t outputStride,
+    const uint8_t *input, size_t inputStride)
+{
+  /* Lanes are packed in reverse order, the last lane is in the high byte */
+  uint32_t x = ((uint32_t)input[7 * inputStride] << 24)
+      | ((uint32_t)input[6 * inputStride] << 16)
+      | ((uint32_t)input[5 * inputStride] << 8)
+      | (uint32_t)input[4 * inputStride];
+  uint32_t y = ((uint32_t)input[3 * inputStride] << 24)
+      | ((uint32_t)input[2 * inputStride] << 16)
+      | ((uint32_t)input[1 * inputStride] << 8)
+      | (uint32_t)input[0];
+  uint32_t t;
+
+  /* Swap 1x1, 2x2 and 4x4 blocks */
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;
+  y = y ^ t ^ (t << 7);
+
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;
+  y = y ^ t ^ (t << 14);
+
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+
+  output[0] = (uint8_t)(x >> 24);
+  output[1 * outputStride] = (uint8_t)(x >> 16);
+  output[2 * outputStride] = (uint8_t)(x >> 8);
+  output[3 * outputStride] = (uint8_t)x;
+  output[4 * outputStride] = (uint8_t)(y >> 24);
+  output[5 * outputStride] = (uint8_t)(y >> 16);
+  output[6 * outputStride] = (uint8_t)(y >> 8);
+  output[7 * outputStride] = (uint8_t)y;
+}
@@ -0,0 +1,107 @@
+/*
+ * helpers/led_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_LED_HELPERS_H_
+#define HELPERS_LED_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/interface.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Size of the engine memory in bytes for the specified number of LEDs */
+#define LED_ENGINE_MEMORY_SIZE(count) \
+    ((((count) * 9 + 3) & ~(size_t)3) + (((count) + 31) / 32) * 8)
+
+/* Number of lanes of the parallel output, one bus line for each lane */
+#define WS281X_PARALLEL_LANES 8
+/* Symbol rate of the parallel bus, each data bit takes three symbols */
+#define WS281X_PARALLEL_RATE  2400000
+
+extern const struct InterfaceClass * const WS281xParallel;
+
+struct LedChain
+{
+  struct Interface *output;
+  /* Position of the first LED of the chain and number of LEDs */
+  size_t first;
+  size_t count;
+};
+
+struct LedEngine
+{
+  struct LedChain *chains;
+  size_t count;
+  /* Total number of LEDs in all chains */
+  size_t length;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* LEDs changed since the frame buffer was rendered, one bit for each LED */
+  uint32_t *dirty[2];
+  /* Colors set by the application, 3 bytes for each LED in RGB order */
+  uint8_t *colors;
+  /* Encoded frames in GRB order, one is transmitted while other is rendered */
+  uint8_t *frames[2];
+
+  /* Gamma correction table scaled by the brightness */
+  uint8_t table[256];
+  uint8_t brightness;
+  /* Frame buffer being rendered */
+  uint8_t back;
+
+  /* Statistics */
+  unsigned long encoded;
+  unsigned long transmitted;
+
+  /* Chains with transfers in progress, one more while the frame is started */
+  volatile size_t active;
+};
+
+struct WS281xParallelConfig
+{
+  /**
+   * Mandatory: 8-bit parallel bus with the WS281X_PARALLEL_RATE rate.
+   * The bus is owned by the output and is released on deinitialization.
+   */
+  struct Interface *bus;
+  /** Mandatory: number of LEDs in each lane. */
+  size_t size;
+};
+
+struct WS281xParallel
+{
+  struct Interface base;
+
+  struct Interface *bus;
+
+  /* Bit-transposed symbols of all lanes followed by the reset period */
+  uint8_t *buffer;
+  size_t length;
+  /* Number of LEDs in each lane */
+  size_t size;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void ledChainInit(struct LedChain *, struct Interface *, size_t);
+
+bool ledEngineInit(struct LedEngine *, struct LedChain *, size_t, void *,
+    size_t);
+void ledEngineFill(struct LedEngine *, uint32_t);
+bool ledEngineIsBusy(const struct LedEngine *);
+void ledEngineRender(struct LedEngine *);
+void ledEngineSetBrightness(struct LedEngine *, uint8_t);
+void ledEngineSetCallback(struct LedEngine *, void (*)(void *), void *);
+void ledEngineSetColor(struct LedEngine *, size_t, uint32_t);
+bool ledEngineUpdate(struct LedEngine *);
+
+void ws281xTranspose(uint8_t *, size_t, const uint8_t *, size_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_LED_HELPERS_H_ */
@@ -0,0 +1,378 @@
+/*
+ * helpers/log_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "log_helpers.h"
+#include <halm/generic/flash.h>
+#include <halm/wq.h>
+#include <xcore/interface.h>
+#include <xcore/memory.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static void logComplete(struct FlashLog *);
+static void logIssue(struct FlashLog *);
+static bool logIsPageErased(struct FlashLog *, uint32_t);
+static void logProcess(struct FlashLog *);
+static bool logReadHeader(struct FlashLog *, uint32_t,
+    struct FlashLogHeader *);
+static void logRecover(struct FlashLog *);
+static void logStepTask(void *);
+static void onLogEvent(void *);
+/*----------------------------------------------------------------------------*/
+static inline uint32_t logAdvance(const struct FlashLog *log, uint32_t offset)
+{
+  offset += FLASH_LOG_PAGE_SIZE;
+  return offset < log->length ? offset : 0;
+}
+/*----------------------------------------------------------------------------*/
+static void logComplete(struct FlashLog *log)
+{
+  const bool failed = log->rejected
+      || ifGetParam(log->memory, IF_STATUS, NULL) != E_OK;
+
+  /*
+   * Failed programming operations are counted but not retried: the log
+   * should keep running and accepting samples even when the memory is worn
+   * out. Failed erases add no free space, the sector ahead of the write head
+   * is erased again and the sector at the write head is skipped.
+   */
+  if (failed)
+    ++log->errors;
+
+  switch (log->state)
+  {
+    case FLASH_LOG_ERASE:
+      if (!failed)
+      {
+        log->free += log->sector;
+        ++log->erased;
+      }
+      else if (!log->free)
+      {
+        /* Sector at the write head cannot be used, it is skipped */
+        log->head += log->sector;
+        if (log->head >= log->length)
+          log->head = 0;
+      }
+      break;
+
+    case FLASH_LOG_HEADER:
+      log->head = logAdvance(log, log->head);
+      log->free -= FLASH_LOG_PAGE_SIZE;
+      break;
+
+    case FLASH_LOG_PROGRAM:
+      log->head = logAdvance(log, log->head);
+      log->free -= FLASH_LOG_PAGE_SIZE;
+      log->tail = (log->tail + FLASH_LOG_PAGE_SIZE) % log->size;
+      log->count -= FLASH_LOG_PAGE_SIZE;
+
+      if (!failed)
+        log->written += FLASH_LOG_PAGE_SIZE;
+      break;
+
+    default:
+      break;
+  }
+
+  log->rejected = false;
+  log->state = FLASH_LOG_IDLE;
+}
+/*----------------------------------------------------------------------------*/
+static void logIssue(struct FlashLog *log)
+{
+  const size_t pages = log->count / FLASH_LOG_PAGE_SIZE;
+  const size_t low = log->size / FLASH_LOG_PAGE_SIZE / 4;
+  const uint32_t position = log->position + log->head;
+
+  /*
+   * Sectors are erased ahead of the write head while the ring buffer is
+   * almost empty, so that erase latency is hidden between sample bursts.
+   * Erase becomes mandatory only when the write head reaches the end
+   * of the erased area.
+   */
+  if (log->free < FLASH_LOG_AHEAD * log->sector && (!log->free || pages < low))
+  {
+    uint32_t target = log->head + log->free;
+    enum Result res;
+
+    if (target >= log->length)
+      target -= log->length;
+    target += log->position;
+
+    log->state = FLASH_LOG_ERASE;
+    res = ifSetParam(log->memory, IF_FLASH_ERASE_SECTOR, &target);
+
+    if (res != E_OK && res != E_BUSY)
+    {
+      /*
+       * Operation was not started and the event will never come.
+       * Nothing is credited, the erase is retried on the next write.
+       */
+      ++log->errors;
+      log->state = FLASH_LOG_IDLE;
+    }
+    return;
+  }
+
+  if (!pages)
+    return;
+
+  if (log->head % log->sector == 0)
+  {
+    const uint32_t sequence = log->sequence + 1;
+
+    log->header = (struct FlashLogHeader){
+        .magic = FLASH_LOG_MAGIC,
+        .sequence = sequence,
+        .check = ~sequence,
+        .sector = log->sector
+    };
+    log->sequence = sequence;
+    log->state = FLASH_LOG_HEADER;
+
+    if (ifSetParam(log->memory, IF_POSITION, &position) != E_OK
+        || ifWrite(log->memory, &log->header, sizeof(log->header))
+            != sizeof(log->header))
+    {
+      /* Operation was not started or was truncated, no event will come */
+      log->rejected = true;
+      log->event = true;
+    }
+  }
+  else
+  {
+    log->state = FLASH_LOG_PROGRAM;
+
+    /* Page is programmed directly from the ring buffer */
+    if (ifSetParam(log->memory, IF_POSITION, &position) != E_OK
+        || ifWrite(log->memory, log->buffer + log->tail, FLASH_LOG_PAGE_SIZE)
+            != FLASH_LOG_PAGE_SIZE)
+    {
+      /* Operation was not started or was truncated, no event will come */
+      log->rejected = true;
+      log->event = true;
+    }
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool logIsPageErased(struct FlashLog *log, uint32_t position)
+{
+  /* Ring buffer is not used yet and serves as a temporary page buffer */
+  uint8_t * const page = log->buffer;
+
+  if (ifSetParam(log->memory, IF_POSITION, &position) != E_OK)
+    return false;
+  if (ifRead(log->memory, page, FLASH_LOG_PAGE_SIZE) != FLASH_LOG_PAGE_SIZE)
+    return false;
+
+  for (size_t i = 0; i < FLASH_LOG_PAGE_SIZE; ++i)
+  {
+    if (page[i] != 0xFF)
+      return false;
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void logProcess(struct FlashLog *log)
+{
+  if (log->event)
+  {
+    log->event = false;
+    logComplete(log);
+  }
+
+  /* Pending events are processed in the loop without recursion */
+  while (log->state == FLASH_LOG_IDLE)
+  {
+    logIssue(log);
+
+    if (!log->event)
+      break;
+
+    log->event = false;
+    logComplete(log);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool logReadHeader(struct FlashLog *log, uint32_t index,
+    struct FlashLogHeader *header)
+{
+  const uint32_t position = log->position + index * log->sector;
+
+  if (ifSetParam(log->memory, IF_POSITION, &position) != E_OK)
+    return false;
+  if (ifRead(log->memory, header, sizeof(*header)) != sizeof(*header))
+    return false;
+
+  return header->magic == FLASH_LOG_MAGIC
+      && header->check == ~header->sequence
+      && header->sector == log->sector;
+}
+/*----------------------------------------------------------------------------*/
+static void logRecover(struct FlashLog *log)
+{
+  const uint32_t pages = log->sector / FLASH_LOG_PAGE_SIZE;
+  const uint32_t sectors = log->length / log->sector;
+  uint32_t newest = sectors;
+
+  /* Only sector headers are read, the rest of the log is not scanned */
+  for (uint32_t index = 0; index < sectors; ++index)
+  {
+    struct FlashLogHeader header;
+
+    if (!logReadHeader(log, index, &header))
+      continue;
+
+    if (newest == sectors || header.sequence > log->sequence)
+    {
+      newest = index;
+      log->sequence = header.sequence;
+    }
+  }
+
+  if (newest == sectors)
+  {
+    /* Empty log, the first sector will be erased on the first write */
+    log->head = 0;
+    log->free = 0;
+    return;
+  }
+
+  /* Pages are programmed in order, find the first erased page */
+  const uint32_t base = newest * log->sector;
+  uint32_t first = 1;
+  uint32_t last = pages;
+
+  while (first < last)
+  {
+    const uint32_t middle = (first + last) / 2;
+
+    if (logIsPageErased(log, log->position + base
+        + middle * FLASH_LOG_PAGE_SIZE))
+    {
+      last = middle;
+    }
+    else
+      first = middle + 1;
+  }
+
+  if (first == pages)
+  {
+    log->head = base + log->sector < log->length ? base + log->sector : 0;
+    log->free = 0;
+  }
+  else
+  {
+    log->head = base + first * FLASH_LOG_PAGE_SIZE;
+    log->free = log->sector - first * FLASH_LOG_PAGE_SIZE;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void logStepTask(void *argument)
+{
+  logProcess(argument);
+}
+/*----------------------------------------------------------------------------*/
+static void onLogEvent(void *argument)
+{
+  struct FlashLog * const log = argument;
+
+  log->event = true;
+  wqAdd(log->wq, logStepTask, log);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the log and recover the write head from sector headers.
+ * The memory is switched to the zero-copy mode on success.
+ * @param log Pointer to a log object.
+ * @param memory Memory interface with sector erase support.
+ * @param wq Work queue for memory event handling.
+ * @param buffer Ring buffer, its size should be a multiple of the page size.
+ * @param size Size of the ring buffer.
+ * @param position Start of the log region, aligned to the sector boundary.
+ * The log region continues up to the end of the memory.
+ * @return @b true on success.
+ */
+bool flashLogInit(struct FlashLog *log, struct Interface *memory,
+    struct WorkQueue *wq, void *buffer, size_t size, uint32_t position)
+{
+  uint32_t capacity = 0;
+  uint32_t sector = 0;
+
+  if (size < 2 * FLASH_LOG_PAGE_SIZE || size % FLASH_LOG_PAGE_SIZE)
+    return false;
+
+  if (ifGetParam(memory, IF_SIZE, &capacity) != E_OK || capacity <= position)
+    return false;
+  if (ifGetParam(memory, IF_FLASH_SECTOR_SIZE, &sector) != E_OK || !sector)
+    return false;
+  if (position % sector || sector % FLASH_LOG_PAGE_SIZE)
+    return false;
+
+  log->memory = memory;
+  log->wq = wq;
+  log->buffer = buffer;
+  log->size = size;
+  log->count = 0;
+  log->peak = 0;
+  log->tail = 0;
+
+  log->position = position;
+  log->length = (capacity - position) / sector * sector;
+  log->sector = sector;
+  log->sequence = 0;
+
+  log->dropped = 0;
+  log->erased = 0;
+  log->errors = 0;
+  log->written = 0;
+
+  log->event = false;
+  log->rejected = false;
+  log->state = FLASH_LOG_IDLE;
+
+  /* Erase-ahead area should never reach the sector with the write head */
+  if (log->length / sector <= FLASH_LOG_AHEAD + 1)
+    return false;
+
+  logRecover(log);
+
+  if (ifSetParam(memory, IF_ZEROCOPY, NULL) != E_OK)
+    return false;
+  ifSetCallback(memory, onLogEvent, log);
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Append data to the log. The function should be called from the work queue
+ * used for memory event handling.
+ * @param log Pointer to a log object.
+ * @param buffer Pointer to a buffer with data.
+ * @param length Length of data.
+ * @return @b true when data was buffered, @b false when data was dropped
+ * because the ring buffer was full.
+ */
+bool flashLogWrite(struct FlashLog *log, const void *buffer, size_t length)
+{
+  if (log->size - log->count < length)
+  {
+    log->dropped += length;
+    return false;
+  }
+
+  const size_t head = (log->tail + log->count) % log->size;
+  const size_t first = MIN(length, log->size - head);
+
+  memcpy(log->buffer + head, buffer, first);
+  memcpy(log->buffer, (const uint8_t *)buffer + first, length - first);
+  log->count += length;
+  log->peak = MAX(log->peak, log->count);
+
+  logProcess(log);
+  return true;
+}
@@ -0,0 +1,96 @@
+/*
+ * helpers/log_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_LOG_HELPERS_H_
+#define HELPERS_LOG_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/error.h>
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Program granularity, first page of each sector holds the sector header */
+#define FLASH_LOG_PAGE_SIZE 256
+/* Number of sectors kept erased ahead of the write head */
+#define FLASH_LOG_AHEAD     2
+/* Signature of the sector header */
+#define FLASH_LOG_MAGIC     0x474F4C57UL
+
+struct Interface;
+struct WorkQueue;
+
+enum [[gnu::packed]] FlashLogState
+{
+  FLASH_LOG_IDLE,
+  FLASH_LOG_ERASE,
+  FLASH_LOG_HEADER,
+  FLASH_LOG_PROGRAM
+};
+
+struct [[gnu::packed]] FlashLogHeader
+{
+  uint32_t magic;
+  /* Sequence number of the sector, incremented on each new sector */
+  uint32_t sequence;
+  /* Inverted sequence number for header validation */
+  uint32_t check;
+  /* Size of the sector, headers from another geometry are ignored */
+  uint32_t sector;
+};
+
+struct FlashLog
+{
+  struct Interface *memory;
+  struct WorkQueue *wq;
+
+  /* Ring buffer with samples, its size is a multiple of the page size */
+  uint8_t *buffer;
+  size_t size;
+  /* Number of buffered bytes, including the page being programmed */
+  size_t count;
+  /* Maximum number of buffered bytes */
+  size_t peak;
+  /* Position of the oldest buffered byte */
+  size_t tail;
+
+  /* Log region */
+  uint32_t position;
+  uint32_t length;
+  uint32_t sector;
+
+  /* Offset of the write head relative to the start of the region */
+  uint32_t head;
+  /* Number of erased bytes available starting from the write head */
+  uint32_t free;
+  /* Sequence number of the current sector */
+  uint32_t sequence;
+
+  /* Statistics */
+  unsigned long dropped;
+  unsigned long erased;
+  unsigned long errors;
+  unsigned long written;
+
+  /* Header of the sector being started, must persist during programming */
+  struct FlashLogHeader header;
+
+  /* Completion flag, set from the memory interrupt */
+  volatile bool event;
+  /* Last operation was rejected by the memory and is treated as failed */
+  bool rejected;
+  enum FlashLogState state;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+bool flashLogInit(struct FlashLog *, struct Interface *, struct WorkQueue *,
+    void *, size_t, uint32_t);
+bool flashLogWrite(struct FlashLog *, const void *, size_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_LOG_HELPERS_H_ */
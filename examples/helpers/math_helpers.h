@@ -9,6 +9,8 @@
 /*----------------------------------------------------------------------------*/
 #include <xcore/helpers.h>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 /*----------------------------------------------------------------------------*/
 #define DEG_TO_RAD  0.01745329251994329577f
 #define RAD_TO_DEG  57.2957795130823208768f
@@ -32,9 +34,31 @@ typedef struct
   Vector3f y;
   Vector3f z;
 } Matrix3x3f;
+
+typedef struct
+{
+  float w;
+  float x;
+  float y;
+  float z;
+} Quaternionf;
 /*----------------------------------------------------------------------------*/
 BEGIN_DECLS
 
+/* Inverse square root with one Newton-Raphson step, relative error 0.2% */
+static inline float fastInvSqrtf(float value)
+{
+  const float half = value * 0.5f;
+  uint32_t bits;
+  float result;
+
+  memcpy(&bits, &value, sizeof(bits));
+  bits = 0x5F375A86UL - (bits >> 1);
+  memcpy(&result, &bits, sizeof(result));
+
+  return result * (1.5f - half * result * result);
+}
+
 static inline void mat3x3fMul(const Matrix3x3f *m1, const Matrix3x3f *m2,
     Matrix3x3f *out)
 {
@@ -91,6 +115,34 @@ static inline float vec2fNorm(const Vector2f *v)
   return sqrtf(v->x * v->x + v->y * v->y);
 }
 
+static inline void quatfMul(const Quaternionf *q1, const Quaternionf *q2,
+    Quaternionf *out)
+{
+  Quaternionf q;
+
+  q.w = q1->w * q2->w - q1->x * q2->x - q1->y * q2->y - q1->z * q2->z;
+  q.x = q1->w * q2->x + q1->x * q2->w + q1->y * q2->z - q1->z * q2->y;
+  q.y = q1->w * q2->y - q1->x * q2->z + q1->y * q2->w + q1->z * q2->x;
+  q.z = q1->w * q2->z + q1->x * q2->y - q1->y * q2->x + q1->z * q2->w;
+
+  *out = q;
+}
+
+static inline void quatfNormalizeFast(Quaternionf *q)
+{
+  const float norm = q->w * q->w + q->x * q->x + q->y * q->y + q->z * q->z;
+
+  if (norm != 0.0f)
+  {
+    const float mul = fastInvSqrtf(norm);
+
+    q->w *= mul;
+    q->x *= mul;
+    q->y *= mul;
+    q->z *= mul;
+  }
+}
+
 static inline void vec2fNormalize(Vector2f *v)
 {
   float norm = vec2fNorm(v);
@@ -155,6 +207,14 @@ static inline void vec3fNormalize(Vector3f *v)
   }
 }
 
+static inline void vec3fNormalizeFast(Vector3f *v)
+{
+  const float norm = vec3fDotProduct(v, v);
+
+  if (norm != 0.0f)
+    vec3fMul(v, fastInvSqrtf(norm), v);
+}
+
 static inline void vec3fMakeOrthogonal(const Vector3f *v1, const Vector3f *v2,
     Vector3f *out)
 {
@@ -0,0 +1,26 @@
+/*
+ * helpers/print_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "print_helpers.h"
+#include <xcore/interface.h>
+/*----------------------------------------------------------------------------*/
+/**
+ * Write the whole text to an interface, the function waits while
+ * the transmit buffer of the interface is full.
+ * @param serial Output interface.
+ * @param text Pointer to a text buffer.
+ * @param length Length of the text.
+ */
+void printText(struct Interface *serial, const char *text, size_t length)
+{
+  while (length)
+  {
+    const size_t written = ifWrite(serial, text, length);
+
+    text += written;
+    length -= written;
+  }
+}
@@ -0,0 +1,21 @@
+/*
+ * helpers/print_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_PRINT_HELPERS_H_
+#define HELPERS_PRINT_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+struct Interface;
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void printText(struct Interface *, const char *, size_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_PRINT_HELPERS_H_ */
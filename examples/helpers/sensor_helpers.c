@@ -6,8 +6,117 @@
 
 #include "sensor_helpers.h"
 #include <assert.h>
-#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Number of values converted by a kernel at once when printing */
+#define FORMAT_CHUNK_LENGTH     4
+/* Number of digits converted with fixed-point arithmetic */
+#define FORMAT_LOWER_DIGITS     8
+/* Scale factor of the fixed-point fraction, rounded up 2^57 / 10^6 */
+#define FORMAT_FRACTION_FACTOR  144115188076ULL
+#define FORMAT_FRACTION_MASK    ((1ULL << 57) - 1)
+/*----------------------------------------------------------------------------*/
+static size_t printDecimal(int, unsigned int, char *);
+
+static void applyDecimalArray8(const void *, const DataFormat *,
+    DecimalNumber *, unsigned int);
+static void applyDecimalArray16(const void *, const DataFormat *,
+    DecimalNumber *, unsigned int);
+static void applyDecimalArray32(const void *, const DataFormat *,
+    DecimalNumber *, unsigned int);
+static void applyFloatArray8(const void *, const DataFormat *, float *);
+static void applyFloatArray16(const void *, const DataFormat *, float *);
+static void applyFloatArray32(const void *, const DataFormat *, float *);
+/*----------------------------------------------------------------------------*/
+/*
+ * Kernels are generated for each element type. Float conversion uses
+ * a multiplication by an exact reciprocal of the power of two and loops
+ * are unrolled to let the compiler use vector instructions when available.
+ */
+#define DEFINE_DECIMAL_KERNEL(type, width) \
+    static void applyDecimalArray##width(const void *values, \
+        const DataFormat *format, DecimalNumber *output, \
+        unsigned int multiplier) \
+    { \
+      const type * const input = values; \
+      \
+      for (size_t index = 0; index < format->n; ++index) \
+      { \
+        output[index] = \
+            applyDataFormatDecimal(input[index], format, multiplier); \
+      } \
+    }
+
+#define DEFINE_FLOAT_KERNEL(type, width) \
+    static void applyFloatArray##width(const void *values, \
+        const DataFormat *format, float *output) \
+    { \
+      const type * restrict const input = values; \
+      float * restrict const result = output; \
+      const float scale = 1.0f / (float)(1UL << format->q); \
+      const size_t count = format->n; \
+      size_t index = 0; \
+      \
+      for (; index + 4 <= count; index += 4) \
+      { \
+        result[index + 0] = (float)input[index + 0] * scale; \
+        result[index + 1] = (float)input[index + 1] * scale; \
+        result[index + 2] = (float)input[index + 2] * scale; \
+        result[index + 3] = (float)input[index + 3] * scale; \
+      } \
+      for (; index < count; ++index) \
+        result[index] = (float)input[index] * scale; \
+    }
+/*----------------------------------------------------------------------------*/
+const DataFormatKernel dataFormatKernelTable[DATA_FORMAT_KERNEL_END] = {
+    [DATA_FORMAT_KERNEL_8] = {applyDecimalArray8, applyFloatArray8},
+    [DATA_FORMAT_KERNEL_16] = {applyDecimalArray16, applyFloatArray16},
+    [DATA_FORMAT_KERNEL_32] = {applyDecimalArray32, applyFloatArray32}
+};
+/*----------------------------------------------------------------------------*/
+static const char digitPairTable[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4',
+    '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4',
+    '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4',
+    '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4',
+    '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4',
+    '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4',
+    '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4',
+    '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
+};
+/*----------------------------------------------------------------------------*/
+/* Equivalent of the "%0*i" conversion, zero width disables padding */
+static size_t printDecimal(int value, unsigned int width, char *output)
+{
+  if (value < 0)
+  {
+    *output = '-';
+    return printUnsigned(-(uint32_t)value, width > 1 ? width - 1 : 0,
+        output + 1) + 1;
+  }
+  else
+    return printUnsigned((uint32_t)value, width, output);
+}
+/*----------------------------------------------------------------------------*/
+DEFINE_DECIMAL_KERNEL(int8_t, 8)
+DEFINE_DECIMAL_KERNEL(int16_t, 16)
+DEFINE_DECIMAL_KERNEL(int32_t, 32)
+DEFINE_FLOAT_KERNEL(int8_t, 8)
+DEFINE_FLOAT_KERNEL(int16_t, 16)
+DEFINE_FLOAT_KERNEL(int32_t, 32)
 /*----------------------------------------------------------------------------*/
 DecimalNumber applyDataFormatDecimal(int32_t raw, const DataFormat *format,
     unsigned int multiplier)
@@ -25,20 +134,11 @@ DecimalNumber applyDataFormatDecimal(int32_t raw, const DataFormat *format,
 }
 /*----------------------------------------------------------------------------*/
 void applyDataFormatDecimalArray(const void *values, const DataFormat *format,
-    DecimalNumber *output, unsigned int multiplier)
+    const DataFormatKernel *kernel, DecimalNumber *output,
+    unsigned int multiplier)
 {
-  const unsigned int width = format->i + format->q;
-  assert(width == 8 || width == 16 || width == 32);
-
-  for (size_t index = 0; index < format->n; ++index)
-  {
-    const int32_t value =
-        (width == 8) ? *((const int8_t *)values + index)
-        : (width == 16) ? *((const int16_t *)values + index)
-        : *((const int32_t *)values + index);
-
-    output[index] = applyDataFormatDecimal(value, format, multiplier);
-  }
+  assert(kernel != NULL);
+  kernel->decimal(values, format, output, multiplier);
 }
 /*----------------------------------------------------------------------------*/
 float applyDataFormatFloat(int32_t raw, const DataFormat *format)
@@ -47,20 +147,10 @@ float applyDataFormatFloat(int32_t raw, const DataFormat *format)
 }
 /*----------------------------------------------------------------------------*/
 void applyDataFormatFloatArray(const void *values, const DataFormat *format,
-    float *output)
+    const DataFormatKernel *kernel, float *output)
 {
-  const unsigned int width = format->i + format->q;
-  assert(width == 8 || width == 16 || width == 32);
-
-  for (size_t index = 0; index < format->n; ++index)
-  {
-    const int32_t value =
-        (width == 8) ? *((const int8_t *)values + index)
-        : (width == 16) ? *((const int16_t *)values + index)
-        : *((const int32_t *)values + index);
-
-    output[index] = applyDataFormatFloat(value, format);
-  }
+  assert(kernel != NULL);
+  kernel->floating(values, format, output);
 }
 /*----------------------------------------------------------------------------*/
 DataFormat parseDataFormat(const char *str)
@@ -142,56 +232,84 @@ DataFormat parseDataFormat(const char *str)
   return error ? (DataFormat){0, 0, 0} : result;
 }
 /*----------------------------------------------------------------------------*/
+const DataFormatKernel *selectDataFormatKernel(const DataFormat *format)
+{
+  switch (format->i + format->q)
+  {
+    case 8:
+      return &dataFormatKernelTable[DATA_FORMAT_KERNEL_8];
+
+    case 16:
+      return &dataFormatKernelTable[DATA_FORMAT_KERNEL_16];
+
+    case 32:
+      return &dataFormatKernelTable[DATA_FORMAT_KERNEL_32];
+
+    default:
+      return NULL;
+  }
+}
+/*----------------------------------------------------------------------------*/
 /**
  * Convert packed integer values from an IQ format to a string.
  * @param values Pointer to an array of packed values, array type will be
  * deduced automatically from the format descriptor.
  * @param format Format descriptor of an input array.
+ * @param kernel Conversion kernel selected for the format.
  * @param integerFormatSign When @b true sign will be added to the integer part.
  * @param decimalFormatPrecision Number of digits in a fractional part.
  * @param output Buffer for an output data.
  * @return Number of characters printed.
  */
 size_t printFormattedValues(const void *values, const DataFormat *format,
-    bool integerFormatSign, unsigned int decimalFormatPrecision, char *output)
+    const DataFormatKernel *kernel, bool integerFormatSign,
+    unsigned int decimalFormatPrecision, char *output)
 {
   static const unsigned int precisionMulTable[] = {
       1, 10, 100, 1000, 10000, 100000, 1000000
   };
 
   assert(values != NULL && format != NULL && output != NULL);
+  assert(kernel != NULL);
   assert(decimalFormatPrecision <= 6);
 
-  const unsigned int mul = precisionMulTable[decimalFormatPrecision];
-  const unsigned int width = format->i + format->q;
-  assert(width == 8 || width == 16 || width == 32);
-
-  const char decimalFormat[] = {
-      '%', '0', '0' + decimalFormatPrecision, 'i', '\0'
-  };
-
+  /* Values are converted in chunks to keep the stack usage bounded */
+  DecimalNumber numbers[FORMAT_CHUNK_LENGTH];
+  const size_t width = (format->i + format->q) / 8;
+  const uint8_t *position = values;
   size_t processed = 0;
 
   for (size_t index = 0; index < format->n; ++index)
   {
-    const int32_t value =
-        (width == 8) ? *((const int8_t *)values + index)
-        : (width == 16) ? *((const int16_t *)values + index)
-        : *((const int32_t *)values + index);
+    const size_t offset = index % FORMAT_CHUNK_LENGTH;
+
+    if (!offset)
+    {
+      const size_t left = format->n - index;
+      const DataFormat chunk = {
+          format->i,
+          format->q,
+          (uint8_t)MIN(left, FORMAT_CHUNK_LENGTH)
+      };
+
+      kernel->decimal(position, &chunk, numbers,
+          precisionMulTable[decimalFormatPrecision]);
+      position += chunk.n * width;
+    }
 
-    const DecimalNumber converted = applyDataFormatDecimal(value, format, mul);
+    const DecimalNumber converted = numbers[offset];
 
     /* Integer part */
     if (integerFormatSign)
       output[processed++] = converted.negative ? '-' : ' ';
-    processed += sprintf(output + processed, "%i", converted.integer);
+    processed += printDecimal(converted.integer, 0, output + processed);
 
     /* Fractional part */
     if (decimalFormatPrecision)
     {
       output[processed++] = '.';
-      processed += sprintf(output + processed, decimalFormat,
-          converted.decimal);
+      processed += printDecimal(converted.decimal, decimalFormatPrecision,
+          output + processed);
     }
 
     /* Element separator */
@@ -199,5 +317,69 @@ size_t printFormattedValues(const void *values, const DataFormat *format,
       output[processed++] = ' ';
   }
 
+  /* Keep the output null-terminated like the sprintf-based version */
+  output[processed] = '\0';
   return processed;
 }
+/*----------------------------------------------------------------------------*/
+/**
+ * Convert an unsigned integer to a string, equivalent of the "%0*u"
+ * conversion. The output is not null-terminated.
+ * @param value Value to be converted.
+ * @param width Minimal number of digits, zero width disables padding.
+ * @param output Buffer for an output data.
+ * @return Number of characters printed.
+ */
+size_t printUnsigned(uint32_t value, unsigned int width, char *output)
+{
+  static const uint32_t powerTable[] = {
+      10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+      1000000000
+  };
+
+  unsigned int digits = 1;
+
+  while (digits < 10 && value >= powerTable[digits - 1])
+    ++digits;
+
+  const unsigned int length = MAX(digits, width);
+  char *position = output;
+
+  memset(position, '0', length - digits);
+  position += length - digits;
+
+  /* Values with more than 8 digits have one or two upper digits */
+  if (digits > FORMAT_LOWER_DIGITS)
+  {
+    const uint32_t upper = value / 100000000;
+
+    value -= upper * 100000000;
+
+    if (upper >= 10)
+    {
+      memcpy(position, digitPairTable + upper * 2, 2);
+      position += 2;
+    }
+    else
+      *position++ = (char)('0' + upper);
+
+    digits = FORMAT_LOWER_DIGITS;
+  }
+
+  /*
+   * Lower 8 digits are extracted from a fixed-point fraction with
+   * the binary point at bit 57: each multiplication by 100 moves the next
+   * pair of digits into the integer part, no division is required.
+   */
+  char lower[FORMAT_LOWER_DIGITS];
+  uint64_t fraction = (uint64_t)value * FORMAT_FRACTION_FACTOR;
+
+  for (size_t i = 0; i < FORMAT_LOWER_DIGITS; i += 2)
+  {
+    memcpy(lower + i, digitPairTable + (fraction >> 57) * 2, 2);
+    fraction = (fraction & FORMAT_FRACTION_MASK) * 100;
+  }
+
+  memcpy(position, lower + FORMAT_LOWER_DIGITS - digits, digits);
+  return length;
+}
@@ -25,17 +25,43 @@ typedef struct
   int decimal;
   bool negative;
 } DecimalNumber;
+
+/* Conversion routines specialized for an element width */
+typedef struct
+{
+  void (*decimal)(const void *, const DataFormat *, DecimalNumber *,
+      unsigned int);
+  void (*floating)(const void *, const DataFormat *, float *);
+} DataFormatKernel;
+
+enum
+{
+  DATA_FORMAT_KERNEL_8,
+  DATA_FORMAT_KERNEL_16,
+  DATA_FORMAT_KERNEL_32,
+
+  DATA_FORMAT_KERNEL_END
+};
+
+/* Select a kernel statically when the element width is known in advance */
+#define DATA_FORMAT_KERNEL(width) \
+    (&dataFormatKernelTable[DATA_FORMAT_KERNEL_##width])
+
+extern const DataFormatKernel dataFormatKernelTable[DATA_FORMAT_KERNEL_END];
 /*----------------------------------------------------------------------------*/
 BEGIN_DECLS
 
 DecimalNumber applyDataFormatDecimal(int32_t, const DataFormat *, unsigned int);
 void applyDataFormatDecimalArray(const void *, const DataFormat *,
-    DecimalNumber *, unsigned int);
+    const DataFormatKernel *, DecimalNumber *, unsigned int);
 float applyDataFormatFloat(int32_t, const DataFormat *);
-void applyDataFormatFloatArray(const void *, const DataFormat *, float *);
+void applyDataFormatFloatArray(const void *, const DataFormat *,
+    const DataFormatKernel *, float *);
 DataFormat parseDataFormat(const char *);
-size_t printFormattedValues(const void *, const DataFormat *, bool,
-    unsigned int, char *);
+const DataFormatKernel *selectDataFormatKernel(const DataFormat *);
+size_t printFormattedValues(const void *, const DataFormat *,
+    const DataFormatKernel *, bool, unsigned int, char *);
+size_t printUnsigned(uint32_t, unsigned int, char *);
 
 END_DECLS
 /*----------------------------------------------------------------------------*/
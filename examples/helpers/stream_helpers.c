@@ -0,0 +1,345 @@
+/*
+ * helpers/stream_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "stream_helpers.h"
+#include <halm/timer.h>
+#include <halm/wq.h>
+#include <xcore/interface.h>
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+static bool channelTransfer(struct StreamChannel *);
+static size_t latencyToBucket(uint32_t);
+static uint32_t ticksToMicroseconds(struct Timer *, uint32_t);
+static void onBridgeEvent(void *);
+static void onSourceEvent(void *);
+static void transferTask(void *);
+/*----------------------------------------------------------------------------*/
+static bool channelTransfer(struct StreamChannel *channel)
+{
+  size_t left = channel->budget;
+  bool blocked = false;
+
+  while (!blocked && left)
+  {
+    if (!channel->pending)
+    {
+      /* Paused channel completes the pending chunk only */
+      if (channel->paused)
+        break;
+
+      size_t available = 0;
+      size_t space = channel->size;
+
+      if (ifGetParam(channel->source, IF_RX_AVAILABLE, &available) != E_OK)
+        available = channel->size;
+      if (!available)
+        break;
+
+      /* Data is read only when the sink is able to accept it */
+      ifGetParam(channel->sink, IF_TX_AVAILABLE, &space);
+      if (!space)
+      {
+        blocked = true;
+        break;
+      }
+
+      channel->offset = 0;
+      channel->pending = ifRead(channel->source, channel->buffer,
+          MIN(MIN(available, space), MIN(left, channel->size)));
+
+      if (!channel->pending)
+        break;
+      ++channel->chunks;
+    }
+
+    const size_t written = ifWrite(channel->sink,
+        channel->buffer + channel->offset, channel->pending);
+
+    channel->bytes += written;
+    channel->offset += written;
+    channel->pending -= written;
+    left -= written;
+
+    /* Remaining part of the chunk is kept until the sink frees space */
+    blocked = channel->pending > 0;
+  }
+
+  if (blocked && !channel->blocked)
+    ++channel->stalls;
+  channel->blocked = blocked;
+
+  /* Channel may have more data when the whole budget is used */
+  return !left;
+}
+/*----------------------------------------------------------------------------*/
+static size_t latencyToBucket(uint32_t ticks)
+{
+  size_t bucket = 0;
+
+  while (ticks > 1 && bucket < STREAM_HISTOGRAM_BUCKETS - 1)
+  {
+    ticks >>= 1;
+    ++bucket;
+  }
+
+  return bucket;
+}
+/*----------------------------------------------------------------------------*/
+static void onBridgeEvent(void *argument)
+{
+  struct StreamBridge * const bridge = argument;
+
+  if (!bridge->queued)
+  {
+    bridge->queued = true;
+    wqAdd(WQ_DEFAULT, transferTask, argument);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void onSourceEvent(void *argument)
+{
+  struct StreamChannel * const channel = argument;
+  struct StreamBridge * const bridge = channel->bridge;
+
+  /* Latency is measured from the first event of the data not served yet */
+  if (bridge->timer != NULL && !channel->waiting)
+  {
+    size_t available = 1;
+
+    /* Source may also be the sink of another channel */
+    ifGetParam(channel->source, IF_RX_AVAILABLE, &available);
+
+    if (available)
+    {
+      channel->arrival = timerGetValue(bridge->timer);
+      channel->waiting = true;
+    }
+  }
+
+  onBridgeEvent(bridge);
+}
+/*----------------------------------------------------------------------------*/
+static void transferTask(void *argument)
+{
+  struct StreamBridge * const bridge = argument;
+  bool exhausted = false;
+
+  /* Events during the transfer enqueue the task again */
+  bridge->queued = false;
+
+  for (size_t i = 0; i < bridge->count; ++i)
+  {
+    struct StreamChannel * const channel =
+        &bridge->channels[(bridge->next + i) % bridge->count];
+    const unsigned long bytes = channel->bytes;
+    const uint32_t arrival = channel->arrival;
+    const bool waiting = channel->waiting;
+
+    /* Events during the transfer record the arrival of the next data */
+    channel->waiting = false;
+
+    const bool more = channelTransfer(channel);
+
+    if (more)
+      exhausted = true;
+    if (!waiting)
+      continue;
+
+    if (more || channel->blocked || channel->paused)
+    {
+      /* Data of the recorded event is not served completely yet */
+      channel->waiting = true;
+      channel->arrival = arrival;
+    }
+    else if (channel->bytes != bytes)
+    {
+      /* Latency includes the time spent serving the preceding channels */
+      const uint32_t ticks = timerGetValue(bridge->timer) - arrival;
+
+      channel->latencySum += ticks;
+      if (ticks > channel->latencyMax)
+        channel->latencyMax = ticks;
+      ++channel->samples;
+
+      if (channel->histogram != NULL)
+        ++channel->histogram[latencyToBucket(ticks)];
+    }
+  }
+
+  /* Each channel is served first in turn */
+  bridge->next = (bridge->next + 1) % bridge->count;
+
+  /* Other tasks are allowed to run before the next pass */
+  if (exhausted)
+    onBridgeEvent(bridge);
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t ticksToMicroseconds(struct Timer *timer, uint32_t ticks)
+{
+  const uint64_t frequency = timerGetFrequency(timer);
+  return (uint32_t)(((uint64_t)ticks * 1000000 + frequency / 2) / frequency);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a unidirectional stream channel.
+ * @param channel Pointer to a channel object.
+ * @param source Interface the data is read from.
+ * @param sink Interface the data is written to.
+ * @param buffer Chunk buffer.
+ * @param size Size of the chunk buffer, chunks are limited to this size.
+ * @param budget Maximum number of bytes transferred in one pass, the channel
+ * yields to other channels and tasks when the budget is used.
+ */
+void streamChannelInit(struct StreamChannel *channel, struct Interface *source,
+    struct Interface *sink, void *buffer, size_t size, size_t budget)
+{
+  assert(budget > 0);
+
+  channel->bridge = NULL;
+  channel->source = source;
+  channel->sink = sink;
+
+  channel->buffer = buffer;
+  channel->size = size;
+  channel->offset = 0;
+  channel->pending = 0;
+  channel->budget = budget;
+
+  channel->bytes = 0;
+  channel->chunks = 0;
+  channel->stalls = 0;
+  channel->rate = 0;
+  channel->snapshot = 0;
+  channel->latency = 0;
+  channel->latencyPeak = 0;
+  channel->latencySum = 0;
+  channel->latencyMax = 0;
+  channel->samples = 0;
+  channel->histogram = NULL;
+  channel->arrival = 0;
+
+  channel->waiting = false;
+  channel->blocked = false;
+  channel->paused = false;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Enable latency histogram of the channel. Latencies are measured only
+ * when the bridge has a timer.
+ * @param channel Pointer to a channel object.
+ * @param histogram Array of STREAM_HISTOGRAM_BUCKETS counters, the array
+ * is cleared by the function.
+ */
+void streamChannelSetHistogram(struct StreamChannel *channel,
+    uint32_t *histogram)
+{
+  for (size_t i = 0; i < STREAM_HISTOGRAM_BUCKETS; ++i)
+    histogram[i] = 0;
+
+  channel->histogram = histogram;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize a stream bridge.
+ * @param bridge Pointer to a bridge object.
+ * @param channels Array of initialized channels.
+ * @param count Number of channels.
+ * @param timer Free-running timer for latency measurements, may be NULL.
+ */
+void streamBridgeInit(struct StreamBridge *bridge,
+    struct StreamChannel *channels, size_t count, struct Timer *timer)
+{
+  assert(count > 0);
+
+  /* Reading is destructive, each source is served by a single channel */
+  for (size_t i = 0; i < count; ++i)
+  {
+    for (size_t j = i + 1; j < count; ++j)
+      assert(channels[i].source != channels[j].source);
+
+    channels[i].bridge = bridge;
+  }
+
+  bridge->channels = channels;
+  bridge->count = count;
+  bridge->next = 0;
+  bridge->timer = timer;
+  bridge->queued = false;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Pause or resume a channel of the bridge. Paused channel writes the rest
+ * of the pending chunk and stops reading the source, the sink is free
+ * for other writers when the pending field of the channel becomes zero.
+ * @param bridge Pointer to a bridge object.
+ * @param index Index of the channel.
+ * @param paused Pause the channel when @b true, resume it otherwise.
+ */
+void streamBridgeSetPaused(struct StreamBridge *bridge, size_t index,
+    bool paused)
+{
+  assert(index < bridge->count);
+
+  bridge->channels[index].paused = paused;
+
+  /* Source may already hold data without further events */
+  if (!paused)
+    onBridgeEvent(bridge);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Start data transfers. Events of all sources and sinks are handled
+ * by the bridge: receive events start transfers, transmit events resume
+ * channels blocked by full sinks.
+ * @param bridge Pointer to a bridge object.
+ */
+void streamBridgeStart(struct StreamBridge *bridge)
+{
+  for (size_t i = 0; i < bridge->count; ++i)
+    ifSetCallback(bridge->channels[i].sink, onBridgeEvent, bridge);
+
+  /* Source callbacks replace sink callbacks of the same interfaces */
+  for (size_t i = 0; i < bridge->count; ++i)
+  {
+    ifSetCallback(bridge->channels[i].source, onSourceEvent,
+        &bridge->channels[i]);
+  }
+
+  /* Data received before the start is transferred too */
+  onBridgeEvent(bridge);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Update transfer rates and latencies of all channels. Latencies are
+ * updated only when the bridge has a timer.
+ * @param bridge Pointer to a bridge object.
+ * @param frequency Update frequency in Hz.
+ */
+void streamBridgeUpdateStats(struct StreamBridge *bridge, uint32_t frequency)
+{
+  for (size_t i = 0; i < bridge->count; ++i)
+  {
+    struct StreamChannel * const channel = &bridge->channels[i];
+    const unsigned long bytes = channel->bytes;
+
+    channel->rate = (uint32_t)(bytes - channel->snapshot) * frequency;
+    channel->snapshot = bytes;
+
+    if (bridge->timer != NULL)
+    {
+      const uint32_t average = channel->samples ?
+          channel->latencySum / channel->samples : 0;
+
+      channel->latency = ticksToMicroseconds(bridge->timer, average);
+      channel->latencyPeak = ticksToMicroseconds(bridge->timer,
+          channel->latencyMax);
+
+      channel->latencySum = 0;
+      channel->latencyMax = 0;
+      channel->samples = 0;
+    }
+  }
+}
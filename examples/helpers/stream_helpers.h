@@ -0,0 +1,94 @@
+/*
+ * helpers/stream_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_STREAM_HELPERS_H_
+#define HELPERS_STREAM_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+/* Number of buckets in latency histograms */
+#define STREAM_HISTOGRAM_BUCKETS 16
+
+struct Interface;
+struct StreamBridge;
+struct Timer;
+
+struct StreamChannel
+{
+  struct StreamBridge *bridge;
+  struct Interface *source;
+  struct Interface *sink;
+
+  /* Chunk buffer and the part of the chunk not accepted by the sink yet */
+  uint8_t *buffer;
+  size_t size;
+  size_t offset;
+  size_t pending;
+  /* Maximum number of bytes transferred in one pass of the bridge */
+  size_t budget;
+
+  /* Statistics */
+  unsigned long bytes;
+  unsigned long chunks;
+  unsigned long stalls;
+  /* Transfer rate in bytes per second and byte counter of the last update */
+  uint32_t rate;
+  unsigned long snapshot;
+  /* Average and maximum latency in microseconds of the last update period */
+  uint32_t latency;
+  uint32_t latencyPeak;
+  /* Latency samples of the current update period in timer ticks */
+  uint32_t latencySum;
+  uint32_t latencyMax;
+  uint32_t samples;
+  /*
+   * Optional latency histogram, bucket N counts latencies from 2^N
+   * to 2^(N+1) - 1 timer ticks, the last bucket counts all longer latencies.
+   */
+  uint32_t *histogram;
+  /* Time of the first receive event not served completely yet */
+  uint32_t arrival;
+
+  /* Arrival time is recorded and the latency sample is pending */
+  volatile bool waiting;
+  /* Sink is full, transfer resumes on the next event of the sink */
+  bool blocked;
+  /* No new chunks are read, the sink may be used by other writers */
+  bool paused;
+};
+
+struct StreamBridge
+{
+  struct StreamChannel *channels;
+  size_t count;
+  /* Channel served first in the next pass */
+  size_t next;
+
+  /* Optional free-running timer for latency measurements */
+  struct Timer *timer;
+
+  /* Transfer task is already in the work queue */
+  bool queued;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void streamChannelInit(struct StreamChannel *, struct Interface *,
+    struct Interface *, void *, size_t, size_t);
+void streamChannelSetHistogram(struct StreamChannel *, uint32_t *);
+
+void streamBridgeInit(struct StreamBridge *, struct StreamChannel *, size_t,
+    struct Timer *);
+void streamBridgeSetPaused(struct StreamBridge *, size_t, bool);
+void streamBridgeStart(struct StreamBridge *);
+void streamBridgeUpdateStats(struct StreamBridge *, uint32_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_STREAM_HELPERS_H_ */
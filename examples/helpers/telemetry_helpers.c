@@ -0,0 +1,128 @@
+/*
+ * helpers/telemetry_helpers.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "telemetry_helpers.h"
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static uint16_t calcCrc16(const uint8_t *, size_t);
+static size_t finalizeFrame(struct TelemetryEncoder *, uint8_t *,
+    enum TelemetryFrameType, int, size_t);
+/*----------------------------------------------------------------------------*/
+/* CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF */
+static uint16_t calcCrc16(const uint8_t *buffer, size_t length)
+{
+  static const uint16_t crcTable[16] = {
+      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+      0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+  };
+
+  uint16_t crc = 0xFFFF;
+
+  while (length--)
+  {
+    crc = (crc << 4) ^ crcTable[(crc >> 12) ^ (*buffer >> 4)];
+    crc = (crc << 4) ^ crcTable[(crc >> 12) ^ (*buffer & 0x0F)];
+    ++buffer;
+  }
+
+  return crc;
+}
+/*----------------------------------------------------------------------------*/
+static size_t finalizeFrame(struct TelemetryEncoder *encoder, uint8_t *frame,
+    enum TelemetryFrameType type, int tag, size_t length)
+{
+  assert(length <= UINT8_MAX);
+
+  frame[0] = TELEMETRY_SYNC;
+  frame[1] = (uint8_t)type;
+  frame[2] = encoder->sequence++;
+  frame[3] = (uint8_t)tag;
+  frame[4] = (uint8_t)length;
+
+  /* Sync byte is not covered by the checksum */
+  const size_t position = TELEMETRY_HEADER_SIZE + length;
+  const uint16_t crc = calcCrc16(frame + 1, position - 1);
+
+  frame[position] = (uint8_t)crc;
+  frame[position + 1] = (uint8_t)(crc >> 8);
+
+  return position + TELEMETRY_CRC_SIZE;
+}
+/*----------------------------------------------------------------------------*/
+void telemetryInit(struct TelemetryEncoder *encoder)
+{
+  encoder->timestamp = 0;
+  encoder->sequence = 0;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Make a data frame with a raw sample.
+ * @param encoder Pointer to an encoder state.
+ * @param output Buffer for a frame, buffer size should be at least
+ * TELEMETRY_FRAME_SIZE(length) bytes.
+ * @param tag Sensor tag.
+ * @param timestamp Timestamp of the sample.
+ * @param payload Raw sample data in an IQ format.
+ * @param length Length of the sample data.
+ * @return Size of the frame.
+ */
+size_t telemetryMakeDataFrame(struct TelemetryEncoder *encoder, void *output,
+    int tag, uint32_t timestamp, const void *payload, size_t length)
+{
+  uint8_t * const frame = output;
+  uint32_t delta = timestamp - encoder->timestamp;
+  size_t position = TELEMETRY_HEADER_SIZE;
+
+  encoder->timestamp = timestamp;
+
+  /* Timestamp delta in LEB128 format, 7 bits per byte */
+  while (delta >= 0x80)
+  {
+    frame[position++] = (uint8_t)(delta | 0x80);
+    delta >>= 7;
+  }
+  frame[position++] = (uint8_t)delta;
+
+  memcpy(frame + position, payload, length);
+  position += length;
+
+  return finalizeFrame(encoder, frame, TELEMETRY_FRAME_DATA, tag,
+      position - TELEMETRY_HEADER_SIZE);
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Make a format frame that describes samples of the sensor.
+ * @param encoder Pointer to an encoder state.
+ * @param output Buffer for a frame, buffer size should be at least
+ * TELEMETRY_FRAME_SIZE(8) bytes.
+ * @param tag Sensor tag.
+ * @param timestamp Absolute timestamp, deltas of following data frames
+ * are calculated relative to this value.
+ * @param type Sensor type.
+ * @param format Data format of the sensor.
+ * @return Size of the frame.
+ */
+size_t telemetryMakeFormatFrame(struct TelemetryEncoder *encoder,
+    void *output, int tag, uint32_t timestamp, uint8_t type,
+    const DataFormat *format)
+{
+  uint8_t * const frame = output;
+  uint8_t * const payload = frame + TELEMETRY_HEADER_SIZE;
+
+  encoder->timestamp = timestamp;
+
+  payload[0] = (uint8_t)timestamp;
+  payload[1] = (uint8_t)(timestamp >> 8);
+  payload[2] = (uint8_t)(timestamp >> 16);
+  payload[3] = (uint8_t)(timestamp >> 24);
+  payload[4] = type;
+  payload[5] = format->i;
+  payload[6] = format->q;
+  payload[7] = format->n;
+
+  return finalizeFrame(encoder, frame, TELEMETRY_FRAME_FORMAT, tag, 8);
+}
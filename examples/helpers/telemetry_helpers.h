@@ -0,0 +1,50 @@
+/*
+ * helpers/telemetry_helpers.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the MIT License
+ */
+
+#ifndef HELPERS_TELEMETRY_HELPERS_H_
+#define HELPERS_TELEMETRY_HELPERS_H_
+/*----------------------------------------------------------------------------*/
+#include "sensor_helpers.h"
+/*----------------------------------------------------------------------------*/
+/* Sync byte, frame type, sequence number, tag and payload length */
+#define TELEMETRY_HEADER_SIZE 5
+/* Maximum length of a timestamp delta encoded as a variable-length integer */
+#define TELEMETRY_DELTA_SIZE  5
+#define TELEMETRY_CRC_SIZE    2
+#define TELEMETRY_SYNC        0xA5
+
+/* Maximum frame size for a payload of the specified length */
+#define TELEMETRY_FRAME_SIZE(length) \
+    (TELEMETRY_HEADER_SIZE + TELEMETRY_DELTA_SIZE + (length) \
+        + TELEMETRY_CRC_SIZE)
+
+enum [[gnu::packed]] TelemetryFrameType
+{
+  /* Timestamp delta and raw sample data */
+  TELEMETRY_FRAME_DATA,
+  /* Absolute timestamp, sensor type and data format */
+  TELEMETRY_FRAME_FORMAT
+};
+
+struct TelemetryEncoder
+{
+  /* Timestamp of the previous frame */
+  uint32_t timestamp;
+  /* Sequence number of the next frame */
+  uint8_t sequence;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void telemetryInit(struct TelemetryEncoder *);
+size_t telemetryMakeDataFrame(struct TelemetryEncoder *, void *, int,
+    uint32_t, const void *, size_t);
+size_t telemetryMakeFormatFrame(struct TelemetryEncoder *, void *, int,
+    uint32_t, uint8_t, const DataFormat *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* HELPERS_TELEMETRY_HELPERS_H_ */
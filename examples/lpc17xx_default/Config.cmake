@@ -26,13 +26,19 @@ set(TEMPLATES_LIST
         display_tft
         display_tft_spi
         i2c_m24
+        i2c_m24_benchmark=i2c_m24:BENCHMARK=true
         irda_bridge
+        irda_bridge_histogram=irda_bridge:HISTOGRAM=true
+        irda_bridge_report=irda_bridge:REPORT=true
         gnss_ublox
         sensor_ds18b20
         sensor_mpu6000
+        sensor_mpu6000_logger=sensor_mpu6000:LOGGER=true,SAMPLE_RATE=1000
         sensor_ms5607
         sensor_sht20
         sensor_xpt2046
         spi_w25
+        spi_w25_benchmark=spi_w25:BENCHMARK=true
+        stream_router
         systick
 )
@@ -5,6 +5,7 @@
  */
 
 #include "board.h"
+#include "dfu_helpers.h"
 #include <dpm/usb/dfu_bridge.h>
 #include <halm/core/cortex/nvic.h>
 #include <halm/generic/flash.h>
@@ -12,6 +13,9 @@
 #include <halm/platform/lpc/backup_domain.h>
 #include <halm/platform/lpc/flash.h>
 #include <halm/platform/lpc/usb_device.h>
+#include <halm/timer.h>
+#include <halm/usb/usb.h>
+#include <halm/usb/usb_langid.h>
 #include <assert.h>
 /*----------------------------------------------------------------------------*/
 #define BOOT_PIN        PIN(2, 10)
@@ -19,13 +23,33 @@
 
 #define FIRMWARE_OFFSET 0x4000
 #define MAGIC_WORD      0x3A84508FUL
-#define TRANSFER_SIZE   128
+/* Transfer buffer is allocated from the heap */
+#define TRANSFER_LIMIT  4096
 /*----------------------------------------------------------------------------*/
+static void customStringHeader(const void *, enum UsbLangId,
+    struct UsbDescriptor *, void *);
+static void customStringReport(const void *, enum UsbLangId,
+    struct UsbDescriptor *, void *);
 static inline void fwRequestClear(void);
 static bool isDfuRequested(void);
 static void onResetRequested(void);
 static void startFirmware(void);
 /*----------------------------------------------------------------------------*/
+static void customStringHeader(const void *, enum UsbLangId,
+    struct UsbDescriptor *header, void *payload)
+{
+  usbStringHeader(header, payload, LANGID_ENGLISH_US);
+}
+/*----------------------------------------------------------------------------*/
+static void customStringReport(const void *argument, enum UsbLangId,
+    struct UsbDescriptor *header, void *payload)
+{
+  char report[DFU_MONITOR_REPORT_LENGTH + 1];
+
+  dfuMonitorGetReport(argument, report);
+  usbStringWrap(header, payload, report);
+}
+/*----------------------------------------------------------------------------*/
 static inline void fwRequestClear(void)
 {
   *(uint32_t *)backupDomainAddress() = 0;
@@ -82,10 +106,22 @@ int main(void)
   struct Timer * const timer = boardSetupTimer();
   struct Entity * const usb = boardSetupUsb();
 
+  /* Download statistics are reported in a custom string descriptor */
+  struct Timer * const monitorTimer = boardSetupTimerAux0();
+  timerEnable(monitorTimer);
+
+  const struct DfuMonitorConfig monitorConfig = {
+      .flash = flash,
+      .timer = monitorTimer,
+      .offset = FIRMWARE_OFFSET
+  };
+  struct Interface * const monitor = init(DfuMonitor, &monitorConfig);
+  assert(monitor != NULL);
+
   const struct DfuConfig dfuConfig = {
       .device = usb,
       .timer = timer,
-      .transferSize = TRANSFER_SIZE
+      .transferSize = dfuCalcTransferSize(layout, regions, TRANSFER_LIMIT)
   };
   struct Dfu * const dfu = init(Dfu, &dfuConfig);
   assert(dfu != NULL);
@@ -93,7 +129,7 @@ int main(void)
   const struct DfuBridgeConfig bridgeConfig = {
       .device = dfu,
       .reset = onResetRequested,
-      .flash = flash,
+      .flash = monitor,
       .offset = FIRMWARE_OFFSET,
       .geometry = layout,
       .regions = regions,
@@ -103,6 +139,11 @@ int main(void)
   assert(bridge != NULL);
   (void)bridge;
 
+  usbDevStringAppend(usb, usbStringBuild(customStringHeader, 0,
+      USB_STRING_HEADER, 0));
+  usbDevStringAppend(usb, usbStringBuild(customStringReport, monitor,
+      USB_STRING_CUSTOM, 0));
+
   /* Start USB enumeration and event loop */
   usbDevSetConnected(usb, true);
   wqStart(WQ_DEFAULT);
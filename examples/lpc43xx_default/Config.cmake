@@ -53,21 +53,29 @@ set(BUNDLE_LIBS "m")
 # Define template list
 set(TEMPLATES_LIST
         attitude_dcm
+        attitude_mahony=attitude_dcm:FILTER=mahony
         button
         button_complex
         display_tft
         display_tft_spi
         i2c_m24
+        i2c_m24_benchmark=i2c_m24:BENCHMARK=true
         gnss_ublox
         sensor_complex
         sensor_hmc5883
         sensor_mpu6000
+        sensor_mpu6000_logger=sensor_mpu6000:LOGGER=true,SAMPLE_RATE=1000
         sensor_mpu6000_spi=sensor_mpu6000:USE_SPI=true
         sensor_ms5607
         sensor_ms5607_spi=sensor_ms5607:USE_SPI=true
         sensor_sht20
         sensor_xpt2046
         spi_w25
+        spi_w25_benchmark=spi_w25:BENCHMARK=true
         spim_w25
+        spim_w25_benchmark=spim_w25:BENCHMARK=true
+        spim_w25_benchmark_dtr=spim_w25:BENCHMARK=true,USE_DTR=true
         systick
+        ws281x
+        ws281x_benchmark=ws281x:BENCHMARK=true,LED_COUNT=128
 )
@@ -5,6 +5,7 @@
  */
 
 #include "board.h"
+#include "led_helpers.h"
 #include <dpm/platform/lpc/sgpio_bus.h>
 #include <halm/delay.h>
 #include <halm/generic/work_queue.h>
@@ -39,6 +40,7 @@
 [[gnu::alias("boardSetupUsb0")]] struct Entity *boardSetupUsb(void);
 
 static void enablePeriphClock(const void *);
+static struct Interface *setupSgpioBus(uint32_t);
 /*----------------------------------------------------------------------------*/
 static const struct ExternalOscConfig extOscConfig = {
     .frequency = 12000000
@@ -63,6 +65,41 @@ static void enablePeriphClock(const void *clock)
   while (!clockReady(clock));
 }
 /*----------------------------------------------------------------------------*/
+static struct Interface *setupSgpioBus(uint32_t prescaler)
+{
+  const struct SgpioBusConfig sgpioBusConfig = {
+      .prescaler = prescaler,
+      .dma = 0,
+      .priority = 0,
+      .inversion = false,
+
+      .pins = {
+          .clock = PIN(PORT_6, 3), /* SGPIO_4 */
+          .data = {
+              PIN(PORT_4, 2), /* SGPIO_8 */
+              PIN(PORT_4, 3), /* SGPIO_9 */
+              PIN(PORT_4, 4), /* SGPIO_10 */
+              PIN(PORT_4, 5), /* SGPIO_11 */
+              PIN(PORT_4, 6), /* SGPIO_12 */
+              PIN(PORT_4, 8), /* SGPIO_13 */
+              PIN(PORT_4, 9), /* SGPIO_14 */
+              PIN(PORT_4, 10) /* SGPIO_15 */
+          },
+          .dma = SGPIO_3
+      },
+
+      .slices = {
+          .gate = SGPIO_SLICE_P,
+          .qualifier = SGPIO_SLICE_A /* SGPIO_0 */
+      }
+  };
+
+  /* Timer 0 will be used as a DMA event source */
+  struct Interface * const interface = init(SgpioBus, &sgpioBusConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
 void boardResetClock(void)
 {
   clockEnable(MainClock, &(struct GenericClockConfig){CLOCK_INTERNAL});
@@ -249,40 +286,10 @@ struct Interrupt *boardSetupButton(enum InputEvent event)
 /*----------------------------------------------------------------------------*/
 struct Interface *boardSetupDisplayBus(void)
 {
-  static const struct SgpioBusConfig sgpioBusConfig = {
-      .prescaler = 4,
-      .dma = 0,
-      .priority = 0,
-      .inversion = false,
-
-      .pins = {
-          .clock = PIN(PORT_6, 3), /* SGPIO_4 */
-          .data = {
-              PIN(PORT_4, 2), /* SGPIO_8 */
-              PIN(PORT_4, 3), /* SGPIO_9 */
-              PIN(PORT_4, 4), /* SGPIO_10 */
-              PIN(PORT_4, 5), /* SGPIO_11 */
-              PIN(PORT_4, 6), /* SGPIO_12 */
-              PIN(PORT_4, 8), /* SGPIO_13 */
-              PIN(PORT_4, 9), /* SGPIO_14 */
-              PIN(PORT_4, 10) /* SGPIO_15 */
-          },
-          .dma = SGPIO_3
-      },
-
-      .slices = {
-          .gate = SGPIO_SLICE_P,
-          .qualifier = SGPIO_SLICE_A /* SGPIO_0 */
-      }
-  };
-
   /* Clock for SGPIO register interface */
   enablePeriphClock(PeriphClock);
 
-  /* Timer 0 will be used as a DMA event source */
-  struct Interface * const interface = init(SgpioBus, &sgpioBusConfig);
-  assert(interface != NULL);
-  return interface;
+  return setupSgpioBus(4);
 }
 /*----------------------------------------------------------------------------*/
 struct Interface *boardSetupI2C0(void)
@@ -657,3 +664,26 @@ struct Entity *boardSetupUsb1(void)
   assert(usb != NULL);
   return usb;
 }
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupWS281x(size_t size)
+{
+  /*
+   * SGPIO slices drive all lanes at once, only one output may exist.
+   * The output owns the bus and releases the slices when deleted, so
+   * outputs of different lengths may be created one after another.
+   */
+
+  /* Clock for SGPIO register interface */
+  enablePeriphClock(PeriphClock);
+
+  /* Lanes are mapped to the data lines of the display bus */
+  const uint32_t prescaler = clockFrequency(PeriphClock) / WS281X_PARALLEL_RATE;
+  const struct WS281xParallelConfig ws281xConfig = {
+      .bus = setupSgpioBus(prescaler),
+      .size = size
+  };
+
+  struct Interface * const interface = init(WS281xParallel, &ws281xConfig);
+  assert(interface != NULL);
+  return interface;
+}
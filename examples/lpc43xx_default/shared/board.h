@@ -56,6 +56,8 @@
 #define BOARD_USB_MSC_RX        0x01
 #define BOARD_USB_MSC_TX        0x81
 
+#define BOARD_WS281X_LANES      8
+
 DEFINE_WQ_IRQ(WQ_LP)
 /*----------------------------------------------------------------------------*/
 struct Entity;
@@ -104,5 +106,6 @@ struct Interrupt *boardSetupTouchEvent(enum InputEvent, enum PinPull);
 struct Entity *boardSetupUsb(void);
 struct Entity *boardSetupUsb0(void);
 struct Entity *boardSetupUsb1(void);
+struct Interface *boardSetupWS281x(size_t);
 /*----------------------------------------------------------------------------*/
 #endif /* LPC43XX_DEFAULT_SHARED_BOARD_H_ */
@@ -5,6 +5,7 @@
  */
 
 #include "board.h"
+#include "dfu_helpers.h"
 #include <halm/core/cortex/systick.h>
 #include <halm/delay.h>
 #include <halm/generic/flash.h>
@@ -23,7 +24,12 @@
 #include <dpm/usb/dfu_bridge.h>
 #include <assert.h>
 /*----------------------------------------------------------------------------*/
-#define TRANSFER_SIZE 128
+/* Transfer buffer is allocated from the heap, the limit fits all parts */
+#define TRANSFER_SIZE_LIMIT 4096
+/* Area erased in the background ahead of the write pointer */
+#define PREERASE_LENGTH     65536
+/* Patches are applied to memories with sectors up to this size */
+#define PATCH_SECTOR_LIMIT  4096
 
 [[gnu::alias("boardSetupUsb0")]] struct Entity *boardSetupUsb(void);
 /*----------------------------------------------------------------------------*/
@@ -164,10 +170,58 @@ void boardSetupDfuPackage(struct DfuPackage *package,
   package->timer = timerFactoryCreate(factory);
   package->usb = boardSetupUsb();
 
+  /* Free-running timer with millisecond resolution */
+  package->monitorTimer = timerFactoryCreate(factory);
+  timerEnable(package->monitorTimer);
+
+  const size_t transferSize = dfuCalcTransferSize(geometry, regions,
+      TRANSFER_SIZE_LIMIT);
+
+  /* Programming and erasing overlap with USB transfers */
+  const struct DfuPipelineConfig pipelineConfig = {
+      .flash = flash,
+      .geometry = geometry,
+      .regions = regions,
+      .size = transferSize,
+      .ahead = PREERASE_LENGTH
+  };
+  package->pipeline = init(DfuPipeline, &pipelineConfig);
+  assert(package->pipeline != NULL);
+
+  /* Patches are applied to the installed image sector by sector */
+  const struct DfuPatcherConfig patcherConfig = {
+      .flash = package->pipeline,
+      .geometry = geometry,
+      .regions = regions,
+      .offset = offset,
+      .size = PATCH_SECTOR_LIMIT
+  };
+  package->patcher = init(DfuPatcher, &patcherConfig);
+  assert(package->patcher != NULL);
+
+  /* Compressed images are decoded before programming */
+  const struct DfuDecoderConfig decoderConfig = {
+      .flash = package->patcher,
+      .geometry = geometry,
+      .regions = regions,
+      .offset = offset,
+      .size = transferSize
+  };
+  package->decoder = init(DfuDecoder, &decoderConfig);
+  assert(package->decoder != NULL);
+
+  const struct DfuMonitorConfig monitorConfig = {
+      .flash = package->decoder,
+      .timer = package->monitorTimer,
+      .offset = offset
+  };
+  package->monitor = init(DfuMonitor, &monitorConfig);
+  assert(package->monitor != NULL);
+
   const struct DfuConfig dfuConfig = {
       .device = package->usb,
       .timer = package->timer,
-      .transferSize = TRANSFER_SIZE
+      .transferSize = transferSize
   };
   package->dfu = init(Dfu, &dfuConfig);
   assert(package->dfu != NULL);
@@ -175,7 +229,7 @@ void boardSetupDfuPackage(struct DfuPackage *package,
   const struct DfuBridgeConfig bridgeConfig = {
       .device = package->dfu,
       .reset = reset,
-      .flash = flash,
+      .flash = package->monitor,
       .offset = offset,
       .geometry = geometry,
       .regions = regions,
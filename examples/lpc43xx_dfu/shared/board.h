@@ -43,6 +43,14 @@ struct DfuPackage
   struct Entity *usb;
   struct Dfu *dfu;
   struct DfuBridge *bridge;
+
+  /* Download statistics of the bridge */
+  struct Timer *monitorTimer;
+  struct Interface *monitor;
+  /* Memory proxies for compressed images, patches and background programming */
+  struct Interface *decoder;
+  struct Interface *patcher;
+  struct Interface *pipeline;
 };
 
 struct MemoryPackage
@@ -5,6 +5,7 @@
  */
 
 #include "board.h"
+#include "dfu_helpers.h"
 #include <halm/core/cortex/nvic.h>
 #include <halm/generic/work_queue.h>
 #include <halm/interrupt.h>
@@ -30,6 +31,8 @@ static void boardInit(struct Board *);
 static void boardDeinit(struct Board *);
 static void customStringHeader(const void *, enum UsbLangId,
     struct UsbDescriptor *, void *);
+static void customStringReport(const void *, enum UsbLangId,
+    struct UsbDescriptor *, void *);
 static void customStringWrapper(const void *, enum UsbLangId,
     struct UsbDescriptor *, void *);
 static void onButtonPressed(void *);
@@ -77,6 +80,11 @@ static void boardDeinit(struct Board *board)
   interruptDisable(board->buttonPackage.button);
   timerDisable(board->timerPackage.timer);
   deinit(board->dfuPackage.bridge);
+  deinit(board->dfuPackage.monitor);
+  deinit(board->dfuPackage.decoder);
+  deinit(board->dfuPackage.patcher);
+  deinit(board->dfuPackage.pipeline);
+  deinit(board->dfuPackage.monitorTimer);
   deinit(board->dfuPackage.dfu);
   deinit(board->dfuPackage.usb);
   deinit(board->dfuPackage.timer);
@@ -97,6 +105,15 @@ static void customStringHeader(const void *, enum UsbLangId,
   usbStringHeader(header, payload, LANGID_ENGLISH_US);
 }
 /*----------------------------------------------------------------------------*/
+static void customStringReport(const void *argument, enum UsbLangId,
+    struct UsbDescriptor *header, void *payload)
+{
+  char report[DFU_MONITOR_REPORT_LENGTH + 1];
+
+  dfuMonitorGetReport(argument, report);
+  usbStringWrap(header, payload, report);
+}
+/*----------------------------------------------------------------------------*/
 static void customStringWrapper(const void *argument, enum UsbLangId,
     struct UsbDescriptor *header, void *payload)
 {
@@ -142,6 +159,9 @@ int main(void)
       customStringHeader, 0, USB_STRING_HEADER, 0));
   usbDevStringAppend(instance.dfuPackage.usb, usbStringBuild(
       customStringWrapper, productStringEn, USB_STRING_PRODUCT, 0));
+  /* Statistics of the last download and upload for the host tools */
+  usbDevStringAppend(instance.dfuPackage.usb, usbStringBuild(
+      customStringReport, instance.dfuPackage.monitor, USB_STRING_CUSTOM, 0));
   usbDevSetConnected(instance.dfuPackage.usb, true);
 
   wqStart(WQ_DEFAULT);
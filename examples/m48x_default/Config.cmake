@@ -42,5 +42,7 @@ set(BUNDLE_LIBS "m")
 # Define template list
 set(TEMPLATES_LIST
         spim_w25:USE_DTR=true
+        spim_w25_benchmark=spim_w25:BENCHMARK=true,BUFFER_SIZE=65536
+        spim_w25_benchmark_dtr=spim_w25:BENCHMARK=true,BUFFER_SIZE=65536,USE_DTR=true
         systick
 )
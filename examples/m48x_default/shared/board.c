@@ -5,6 +5,7 @@
  */
 
 #include "board.h"
+#include <halm/generic/work_queue.h>
 #include <halm/platform/numicro/clocking.h>
 #include <halm/platform/numicro/gptimer.h>
 #include <halm/platform/numicro/hsusb_device.h>
@@ -86,6 +87,16 @@ void boardSetupClockPll(void)
   clockEnable(MainClock, &mainClockConfigPll);
 }
 /*----------------------------------------------------------------------------*/
+void boardSetupDefaultWQ(void)
+{
+  static const struct WorkQueueConfig wqConfig = {
+      .size = 4
+  };
+
+  WQ_DEFAULT = init(WorkQueue, &wqConfig);
+  assert(WQ_DEFAULT != NULL);
+}
+/*----------------------------------------------------------------------------*/
 struct Interrupt *boardSetupButton(void)
 {
   static const struct PinIntConfig buttonIntConfig = {
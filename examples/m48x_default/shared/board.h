@@ -39,6 +39,7 @@ struct Timer;
 /*----------------------------------------------------------------------------*/
 void boardSetupClockExt(void);
 void boardSetupClockPll(void);
+void boardSetupDefaultWQ(void);
 struct Interrupt *boardSetupButton(void);
 struct Interface *boardSetupI2C(void);
 struct Interface *boardSetupQspi(void);
@@ -42,6 +42,14 @@ struct DfuPackage
   struct Entity *usb;
   struct Dfu *dfu;
   struct DfuBridge *bridge;
+
+  /* Download statistics of the bridge */
+  struct Timer *monitorTimer;
+  struct Interface *monitor;
+  /* Memory proxies for compressed images, patches and background programming */
+  struct Interface *decoder;
+  struct Interface *patcher;
+  struct Interface *pipeline;
 };
 
 struct MemoryPackage
@@ -68,6 +76,7 @@ struct Interface *boardSetupSpim(struct Timer *);
 struct Timer *boardSetupTimer(void);
 struct Timer *boardSetupTimerAux0(void);
 struct Timer *boardSetupTimerAux1(void);
+struct Timer *boardSetupTimerAux2(void);
 struct Entity *boardSetupUsb(void);
 struct Entity *boardSetupUsbFs(void);
 struct Entity *boardSetupUsbHs(void);
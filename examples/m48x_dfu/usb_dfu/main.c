@@ -5,10 +5,12 @@
  */
 
 #include "board.h"
+#include "dfu_helpers.h"
 #include <halm/core/cortex/nvic.h>
 #include <halm/generic/work_queue.h>
 #include <halm/interrupt.h>
 #include <halm/usb/usb.h>
+#include <halm/usb/usb_langid.h>
 #include <xcore/asm.h>
 #include <assert.h>
 /*----------------------------------------------------------------------------*/
@@ -24,6 +26,10 @@ struct Board
 /*----------------------------------------------------------------------------*/
 static void boardInit(struct Board *);
 static void boardDeinit(struct Board *);
+static void customStringHeader(const void *, enum UsbLangId,
+    struct UsbDescriptor *, void *);
+static void customStringReport(const void *, enum UsbLangId,
+    struct UsbDescriptor *, void *);
 static void onButtonPressed(void *);
 static void onResetRequested(void);
 static void startFirmware(struct Board *);
@@ -59,6 +65,11 @@ static void boardDeinit(struct Board *board)
   usbDevSetConnected(board->dfuPackage.usb, false);
 
   deinit(board->dfuPackage.bridge);
+  deinit(board->dfuPackage.monitor);
+  deinit(board->dfuPackage.decoder);
+  deinit(board->dfuPackage.patcher);
+  deinit(board->dfuPackage.pipeline);
+  deinit(board->dfuPackage.monitorTimer);
   deinit(board->dfuPackage.dfu);
   deinit(board->dfuPackage.usb);
   deinit(board->dfuPackage.timer);
@@ -71,6 +82,21 @@ static void boardDeinit(struct Board *board)
   pinWrite(board->ind0, BOARD_LED_INV);
 }
 /*----------------------------------------------------------------------------*/
+static void customStringHeader(const void *, enum UsbLangId,
+    struct UsbDescriptor *header, void *payload)
+{
+  usbStringHeader(header, payload, LANGID_ENGLISH_US);
+}
+/*----------------------------------------------------------------------------*/
+static void customStringReport(const void *argument, enum UsbLangId,
+    struct UsbDescriptor *header, void *payload)
+{
+  char report[DFU_MONITOR_REPORT_LENGTH + 1];
+
+  dfuMonitorGetReport(argument, report);
+  usbStringWrap(header, payload, report);
+}
+/*----------------------------------------------------------------------------*/
 static void onButtonPressed(void *argument)
 {
   wqAdd(WQ_DEFAULT, startFirmwareTask, argument);
@@ -106,6 +132,11 @@ int main(void)
   boardSetupDefaultWQ();
   boardInit(&instance);
 
+  /* Statistics of the last download and upload for the host tools */
+  usbDevStringAppend(instance.dfuPackage.usb, usbStringBuild(
+      customStringHeader, 0, USB_STRING_HEADER, 0));
+  usbDevStringAppend(instance.dfuPackage.usb, usbStringBuild(
+      customStringReport, instance.dfuPackage.monitor, USB_STRING_CUSTOM, 0));
   usbDevSetConnected(instance.dfuPackage.usb, true);
   wqStart(WQ_DEFAULT);
 
@@ -0,0 +1,36 @@
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+# Set family name
+set(FAMILY "GENERIC")
+# Set platform type
+set(PLATFORM "LINUX")
+
+# Simulated peripherals run in separate threads
+set(BUNDLE_DEFS "-D_POSIX_C_SOURCE=200809L")
+set(BUNDLE_LIBS m pthread)
+
+# Define template list
+set(TEMPLATES_LIST
+        attitude_dcm
+        attitude_mahony=attitude_dcm:FILTER=mahony
+        button
+        button_complex
+        display_tft
+        display_tft_spi
+        gnss_ublox
+        i2c_m24
+        i2c_m24_benchmark=i2c_m24:BENCHMARK=true
+        i2c_m24_report=i2c_m24:REPORT=true
+        sensor_complex
+        sensor_hmc5883
+        sensor_mpu6000
+        sensor_mpu6000_logger=sensor_mpu6000:LOGGER=true,SAMPLE_RATE=1000
+        sensor_ms5607
+        sensor_sht20
+        sensor_xpt2046
+        spi_w25
+        spi_w25_benchmark=spi_w25:BENCHMARK=true,BUFFER_SIZE=65536
+        ws281x
+        ws281x_benchmark=ws281x:BENCHMARK=true,CHAINS=4,LED_COUNT=1000
+)
@@ -0,0 +1,210 @@
+/*
+ * x86_default/attitude_benchmark/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "attitude_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+/* Simulated duration in seconds */
+#define DURATION        20
+/* Rate of the magnetometer in Hz */
+#define MAG_RATE        75
+/* Constant gyroscope bias in rad/s */
+#define GYRO_BIAS       0.01f
+/*----------------------------------------------------------------------------*/
+struct Samples
+{
+  Vector3f *acc;
+  Vector3f *mag;
+  Vector3f *vel;
+  float (*angles)[3];
+  bool *magReady;
+  size_t count;
+};
+
+struct Result
+{
+  double nanoseconds;
+  float error;
+};
+
+/*----------------------------------------------------------------------------*/
+static float angleDifference(float, float);
+static float getError(const float *, const float *);
+static uint64_t getTime(void);
+static void makeSamples(struct Samples *, unsigned int);
+/*----------------------------------------------------------------------------*/
+static float angleDifference(float a, float b)
+{
+  float difference = fmodf(a - b, 360.0f);
+
+  if (difference > 180.0f)
+    difference -= 360.0f;
+  else if (difference < -180.0f)
+    difference += 360.0f;
+
+  return fabsf(difference);
+}
+/*----------------------------------------------------------------------------*/
+static float getError(const float *angles, const float *expected)
+{
+  float error = 0.0f;
+
+  for (size_t i = 0; i < 3; ++i)
+    error = MAX(error, angleDifference(angles[i] * RAD_TO_DEG, expected[i]));
+
+  return error;
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void)
+{
+  struct timespec current;
+
+  clock_gettime(CLOCK_MONOTONIC, &current);
+  return (uint64_t)current.tv_sec * 1000000000 + (uint64_t)current.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+static void makeSamples(struct Samples *samples, unsigned int rate)
+{
+  /* Field vectors in the reference frame */
+  static const Vector3f gravity = {0.0f, 0.0f, 1.0f};
+  static const Vector3f field = {0.5f, 0.0f, 0.8f};
+
+  /* Rotation around a fixed axis with a constant angular velocity */
+  Vector3f axis = {0.3f, -0.5f, 0.8f};
+  const float speed = 0.5f;
+
+  vec3fNormalize(&axis);
+
+  samples->count = (size_t)rate * DURATION;
+  samples->acc = malloc(samples->count * sizeof(Vector3f));
+  samples->mag = malloc(samples->count * sizeof(Vector3f));
+  samples->vel = malloc(samples->count * sizeof(Vector3f));
+  samples->angles = malloc(samples->count * sizeof(float [3]));
+  samples->magReady = malloc(samples->count * sizeof(bool));
+
+  for (size_t i = 0; i < samples->count; ++i)
+  {
+    const float theta = speed * (float)i / (float)rate;
+    const float s = sinf(theta * 0.5f);
+    const Quaternionf q = {
+        cosf(theta * 0.5f), axis.x * s, axis.y * s, axis.z * s
+    };
+    const Matrix3x3f m = {
+        {
+            1.0f - 2.0f * (q.y * q.y + q.z * q.z),
+            2.0f * (q.x * q.y - q.w * q.z),
+            2.0f * (q.x * q.z + q.w * q.y)
+        }, {
+            2.0f * (q.x * q.y + q.w * q.z),
+            1.0f - 2.0f * (q.x * q.x + q.z * q.z),
+            2.0f * (q.y * q.z - q.w * q.x)
+        }, {
+            2.0f * (q.x * q.z - q.w * q.y),
+            2.0f * (q.y * q.z + q.w * q.x),
+            1.0f - 2.0f * (q.x * q.x + q.y * q.y)
+        }
+    };
+    Matrix3x3f transposed;
+
+    /* Sensors measure reference vectors in the body frame */
+    mat3x3fTranspose(&m, &transposed);
+    mat3x3vec3fMul(&transposed, &gravity, &samples->acc[i]);
+    mat3x3vec3fMul(&transposed, &field, &samples->mag[i]);
+
+    vec3fMul(&axis, speed, &samples->vel[i]);
+    samples->vel[i].x += GYRO_BIAS;
+    samples->vel[i].y += GYRO_BIAS;
+    samples->vel[i].z += GYRO_BIAS;
+
+    samples->magReady[i] = i == 0
+        || (i * MAG_RATE) / rate != ((i - 1) * MAG_RATE) / rate;
+
+    samples->angles[i][0] = atan2f(m.z.y, m.z.z) * RAD_TO_DEG;
+    samples->angles[i][1] = atan2f(m.z.x,
+        sqrtf(m.z.y * m.z.y + m.z.z * m.z.z)) * RAD_TO_DEG;
+    samples->angles[i][2] = atan2f(m.y.x, m.x.x) * RAD_TO_DEG;
+  }
+}
+/*----------------------------------------------------------------------------*/
+/* Filter runner with the timed pass and the pass with error measurement */
+#define DEFINE_FILTER_RUNNER(name, type) \
+    static void run_##name(const struct Samples *samples, float dt, \
+        struct Result *result) \
+    { \
+      struct type filter; \
+      float error = 0.0f; \
+      \
+      name##FilterInit(&filter, dt); \
+      \
+      const uint64_t start = getTime(); \
+      \
+      for (size_t i = 0; i < samples->count; ++i) \
+      { \
+        name##FilterUpdate(&filter, &samples->acc[i], \
+            samples->magReady[i] ? &samples->mag[i] : NULL, \
+            &samples->vel[i]); \
+      } \
+      \
+      result->nanoseconds = (double)(getTime() - start) / samples->count; \
+      \
+      name##FilterInit(&filter, dt); \
+      \
+      for (size_t i = 0; i < samples->count; ++i) \
+      { \
+        name##FilterUpdate(&filter, &samples->acc[i], \
+            samples->magReady[i] ? &samples->mag[i] : NULL, \
+            &samples->vel[i]); \
+        \
+        /* Skip the initial convergence */ \
+        if (i >= samples->count / 2) \
+        { \
+          float angles[3]; \
+          \
+          name##FilterGetAngles(&filter, angles); \
+          error = MAX(error, getError(angles, samples->angles[i])); \
+        } \
+      } \
+      \
+      result->error = error; \
+    }
+
+DEFINE_FILTER_RUNNER(dcm, DcmFilter)
+DEFINE_FILTER_RUNNER(mahony, MahonyFilter)
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  static const unsigned int rates[] = {100, 1000, 8000};
+
+  printf("rate dcm,ns dcm,error mahony,ns mahony,error speedup\n");
+
+  for (size_t i = 0; i < ARRAY_SIZE(rates); ++i)
+  {
+    const float dt = 1.0f / (float)rates[i];
+    struct Result dcmResult;
+    struct Result mahonyResult;
+    struct Samples samples;
+
+    makeSamples(&samples, rates[i]);
+
+    run_dcm(&samples, dt, &dcmResult);
+    run_mahony(&samples, dt, &mahonyResult);
+
+    printf("%u %.1f %.2f %.1f %.2f %.2f\n", rates[i],
+        dcmResult.nanoseconds, dcmResult.error,
+        mahonyResult.nanoseconds, mahonyResult.error,
+        dcmResult.nanoseconds / mahonyResult.nanoseconds);
+
+    free(samples.magReady);
+    free(samples.angles);
+    free(samples.vel);
+    free(samples.mag);
+    free(samples.acc);
+  }
+
+  return EXIT_SUCCESS;
+}
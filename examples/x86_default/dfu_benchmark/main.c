@@ -0,0 +1,159 @@
+/*
+ * x86_default/dfu_benchmark/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "board.h"
+#include "dfu_helpers.h"
+#include "sim_core.h"
+#include <halm/generic/flash.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+/* Transfer size and duration of a USB transfer in microseconds */
+#define TRANSFER_SIZE   4096
+#define TRANSFER_TIME   3000
+/* Length of the area kept erased ahead of the write pointer */
+#define PREERASE_LENGTH 65536
+/*----------------------------------------------------------------------------*/
+static bool runDownload(struct Interface *, uint32_t, uint32_t, unsigned int,
+    uint64_t *);
+static bool verify(struct Interface *, uint32_t, unsigned int);
+/*----------------------------------------------------------------------------*/
+/* Emulation of the DFU bridge: erase on sector boundaries, then program */
+static bool runDownload(struct Interface *memory, uint32_t sector,
+    uint32_t length, unsigned int seed, uint64_t *duration)
+{
+  static uint8_t block[TRANSFER_SIZE];
+  const uint64_t start = simTime();
+
+  srand(seed);
+
+  for (uint32_t position = 0; position < length; position += TRANSFER_SIZE)
+  {
+    /* Next block is received from the host */
+    simWait((uint64_t)TRANSFER_TIME * 1000);
+    for (size_t i = 0; i < sizeof(block); ++i)
+      block[i] = (uint8_t)rand();
+
+    if (!(position % sector))
+    {
+      if (ifSetParam(memory, IF_FLASH_ERASE_SECTOR, &position) != E_OK)
+        return false;
+    }
+
+    if (ifSetParam(memory, IF_POSITION, &position) != E_OK)
+      return false;
+    if (ifWrite(memory, block, sizeof(block)) != sizeof(block))
+      return false;
+  }
+
+  /* Manifestation phase waits for the last operation */
+  if (ifGetParam(memory, IF_STATUS, NULL) != E_OK)
+    return false;
+
+  *duration = simTime() - start;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static bool verify(struct Interface *flash, uint32_t length, unsigned int seed)
+{
+  static uint8_t buffer[TRANSFER_SIZE];
+
+  srand(seed);
+
+  for (uint32_t position = 0; position < length; position += TRANSFER_SIZE)
+  {
+    if (ifSetParam(flash, IF_POSITION, &position) != E_OK)
+      return false;
+    if (ifRead(flash, buffer, sizeof(buffer)) != sizeof(buffer))
+      return false;
+
+    for (size_t i = 0; i < sizeof(buffer); ++i)
+    {
+      if (buffer[i] != (uint8_t)rand())
+        return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  static const uint32_t lengths[] = {131072, 1048576, 4194304};
+
+  struct Interface * const flash = boardSetupFlash();
+  uint32_t capacity;
+  uint32_t sector;
+  bool passed = true;
+
+  if (ifGetParam(flash, IF_SIZE, &capacity) != E_OK
+      || ifGetParam(flash, IF_FLASH_SECTOR_SIZE, &sector) != E_OK)
+  {
+    printf("memory: parameters unavailable\n");
+    return EXIT_FAILURE;
+  }
+
+  const struct FlashGeometry geometry[] = {
+      {
+          .count = capacity / sector,
+          .size = sector,
+          .time = 45
+      }
+  };
+  const struct DfuPipelineConfig pipelineConfig = {
+      .flash = flash,
+      .geometry = geometry,
+      .regions = ARRAY_SIZE(geometry),
+      .size = TRANSFER_SIZE,
+      .ahead = PREERASE_LENGTH
+  };
+
+  printf("size,KiB direct,ms pipelined,ms speedup\n");
+
+  for (size_t i = 0; i < ARRAY_SIZE(lengths); ++i)
+  {
+    const uint32_t length = lengths[i];
+    const unsigned int seed = (unsigned int)i;
+    uint64_t direct, pipelined;
+
+    if (!runDownload(flash, sector, length, seed, &direct)
+        || !verify(flash, length, seed))
+    {
+      printf("%lu: direct download failed\n", (unsigned long)(length / 1024));
+      passed = false;
+      continue;
+    }
+
+    struct Interface * const pipeline = init(DfuPipeline, &pipelineConfig);
+
+    if (pipeline == NULL)
+    {
+      printf("pipeline: initialization failed\n");
+      return EXIT_FAILURE;
+    }
+
+    /* Another image is used, otherwise programming finds the data in place */
+    const bool completed = runDownload(pipeline, sector, length, seed + 1,
+        &pipelined);
+
+    deinit(pipeline);
+
+    if (!completed || !verify(flash, length, seed + 1))
+    {
+      printf("%lu: pipelined download failed\n",
+          (unsigned long)(length / 1024));
+      passed = false;
+      continue;
+    }
+
+    printf("%lu %lu %lu %.2f\n", (unsigned long)(length / 1024),
+        (unsigned long)(direct / 1000000), (unsigned long)(pipelined / 1000000),
+        (double)direct / (double)pipelined);
+  }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
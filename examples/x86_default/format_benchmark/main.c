@@ -0,0 +1,203 @@
+/*
+ * x86_default/format_benchmark/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sensor_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+#define ELEMENT_COUNT 3
+#define SAMPLE_COUNT  4096
+#define ROUND_COUNT   64
+/*----------------------------------------------------------------------------*/
+typedef size_t (*Formatter)(const void *, const DataFormat *,
+    const DataFormatKernel *, bool, unsigned int, char *);
+/*----------------------------------------------------------------------------*/
+static uint64_t getCycles(void);
+static uint64_t getTime(void);
+static void makeSamples(void *, const DataFormat *);
+static size_t printReference(const void *, const DataFormat *,
+    const DataFormatKernel *, bool, unsigned int, char *);
+static void runBenchmark(Formatter, const void *, const DataFormat *,
+    const DataFormatKernel *, unsigned int, double *, double *);
+static bool verify(const void *, const DataFormat *,
+    const DataFormatKernel *, unsigned int);
+/*----------------------------------------------------------------------------*/
+static uint64_t getCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return 0;
+#endif
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void)
+{
+  struct timespec current;
+
+  clock_gettime(CLOCK_MONOTONIC, &current);
+  return (uint64_t)current.tv_sec * 1000000000 + (uint64_t)current.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+static void makeSamples(void *buffer, const DataFormat *format)
+{
+  const unsigned int width = (format->i + format->q) / 8;
+  uint8_t * const bytes = buffer;
+
+  for (size_t i = 0; i < SAMPLE_COUNT * format->n * width; ++i)
+    bytes[i] = (uint8_t)rand();
+}
+/*----------------------------------------------------------------------------*/
+/* Previous implementation based on sprintf, used as a reference */
+static size_t printReference(const void *values, const DataFormat *format,
+    const DataFormatKernel *, bool integerFormatSign,
+    unsigned int decimalFormatPrecision, char *output)
+{
+  static const unsigned int precisionMulTable[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000
+  };
+
+  const unsigned int mul = precisionMulTable[decimalFormatPrecision];
+  const unsigned int width = format->i + format->q;
+  const char decimalFormat[] = {
+      '%', '0', '0' + decimalFormatPrecision, 'i', '\0'
+  };
+
+  size_t processed = 0;
+
+  for (size_t index = 0; index < format->n; ++index)
+  {
+    const int32_t value =
+        (width == 8) ? *((const int8_t *)values + index)
+        : (width == 16) ? *((const int16_t *)values + index)
+        : *((const int32_t *)values + index);
+
+    const DecimalNumber converted = applyDataFormatDecimal(value, format, mul);
+
+    if (integerFormatSign)
+      output[processed++] = converted.negative ? '-' : ' ';
+    processed += sprintf(output + processed, "%i", converted.integer);
+
+    if (decimalFormatPrecision)
+    {
+      output[processed++] = '.';
+      processed += sprintf(output + processed, decimalFormat,
+          converted.decimal);
+    }
+
+    if (index < (size_t)format->n - 1)
+      output[processed++] = ' ';
+  }
+
+  return processed;
+}
+/*----------------------------------------------------------------------------*/
+static void runBenchmark(Formatter formatter, const void *samples,
+    const DataFormat *format, const DataFormatKernel *kernel,
+    unsigned int precision, double *cycles, double *nanoseconds)
+{
+  const size_t stride = format->n * (format->i + format->q) / 8;
+  const uint64_t startCycles = getCycles();
+  const uint64_t startTime = getTime();
+  volatile size_t total = 0;
+  char text[256];
+
+  for (size_t round = 0; round < ROUND_COUNT; ++round)
+  {
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+    {
+      total += formatter((const uint8_t *)samples + i * stride, format,
+          kernel, true, precision, text);
+    }
+  }
+
+  const double elements = (double)ROUND_COUNT * SAMPLE_COUNT * format->n;
+
+  *cycles = (double)(getCycles() - startCycles) / elements;
+  *nanoseconds = (double)(getTime() - startTime) / elements;
+}
+/*----------------------------------------------------------------------------*/
+static bool verify(const void *samples, const DataFormat *format,
+    const DataFormatKernel *kernel, unsigned int precision)
+{
+  const size_t stride = format->n * (format->i + format->q) / 8;
+
+  for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+  {
+    const void * const sample = (const uint8_t *)samples + i * stride;
+
+    for (unsigned int sign = 0; sign < 2; ++sign)
+    {
+      char expected[256];
+      char result[256];
+      const size_t expectedLength =
+          printReference(sample, format, kernel, sign, precision, expected);
+      const size_t resultLength =
+          printFormattedValues(sample, format, kernel, sign, precision,
+              result);
+
+      if (expectedLength != resultLength
+          || memcmp(expected, result, resultLength))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  static const DataFormat formats[] = {
+      {4, 4, ELEMENT_COUNT},
+      {8, 8, ELEMENT_COUNT},
+      {16, 16, ELEMENT_COUNT},
+      {12, 20, ELEMENT_COUNT}
+  };
+  static int32_t samples[SAMPLE_COUNT * ELEMENT_COUNT];
+  bool passed = true;
+
+  srand(0);
+  printf("format precision sprintf,cycles sprintf,ns table,cycles table,ns"
+      " speedup\n");
+
+  for (size_t i = 0; i < ARRAY_SIZE(formats); ++i)
+  {
+    const DataFormat * const format = &formats[i];
+    const DataFormatKernel * const kernel = selectDataFormatKernel(format);
+
+    makeSamples(samples, format);
+
+    for (unsigned int precision = 0; precision <= 6; ++precision)
+    {
+      double referenceCycles, referenceTime;
+      double tableCycles, tableTime;
+
+      if (!verify(samples, format, kernel, precision))
+      {
+        printf("i%uq%u precision %u: output mismatch\n",
+            format->i, format->q, precision);
+        passed = false;
+        continue;
+      }
+
+      runBenchmark(printReference, samples, format, kernel, precision,
+          &referenceCycles, &referenceTime);
+      runBenchmark(printFormattedValues, samples, format, kernel, precision,
+          &tableCycles, &tableTime);
+
+      printf("i%uq%u %u %.1f %.1f %.1f %.1f %.2f\n",
+          format->i, format->q, precision,
+          referenceCycles, referenceTime, tableCycles, tableTime,
+          referenceTime / tableTime);
+    }
+  }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
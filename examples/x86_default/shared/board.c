@@ -0,0 +1,263 @@
+/*
+ * x86_default/shared/board.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "board.h"
+#include "sim_bus.h"
+#include "sim_flash.h"
+#include "sim_hmc5883.h"
+#include "sim_interrupt.h"
+#include "sim_m24.h"
+#include "sim_mpu60xx.h"
+#include "sim_ms56xx.h"
+#include "sim_serial.h"
+#include "sim_sht2x.h"
+#include "sim_timer.h"
+#include "sim_wq.h"
+#include <assert.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+/* Sample period of simulated sensor data-ready signals */
+#define SENSOR_EVENT_PERIOD 1000000
+/* Size of the simulated I2C EEPROM */
+#define EEPROM_SIZE         65536
+/*----------------------------------------------------------------------------*/
+static struct Interrupt *setupPeriodicEvent(uint64_t);
+static struct Timer *setupTimer(void);
+/*----------------------------------------------------------------------------*/
+[[gnu::alias("boardSetupSensorEvent0")]]
+    struct Interrupt *boardSetupSensorEvent(enum InputEvent, enum PinPull);
+[[gnu::alias("boardSetupSpi")]] struct Interface *boardSetupSpiDisplay(void);
+/*----------------------------------------------------------------------------*/
+struct WorkQueue *WQ_LP = NULL;
+/*----------------------------------------------------------------------------*/
+static struct Interrupt *setupPeriodicEvent(uint64_t period)
+{
+  const struct SimInterruptConfig interruptConfig = {
+      .period = period
+  };
+
+  struct Interrupt * const interrupt = init(SimInterrupt, &interruptConfig);
+  assert(interrupt != NULL);
+  return interrupt;
+}
+/*----------------------------------------------------------------------------*/
+static struct Timer *setupTimer(void)
+{
+  static const struct SimTimerConfig timerConfig = {
+      .frequency = 1000000
+  };
+
+  struct Timer * const timer = init(SimTimer, &timerConfig);
+  assert(timer != NULL);
+  return timer;
+}
+/*----------------------------------------------------------------------------*/
+void boardSetupClockExt(void)
+{
+  /* Host clock is always running */
+}
+/*----------------------------------------------------------------------------*/
+void boardSetupClockPll(void)
+{
+  /* Host clock is always running */
+}
+/*----------------------------------------------------------------------------*/
+void boardSetupDefaultWQ(void)
+{
+  /* Tasks run under the interrupt lock and never race with device models */
+  static const struct SimWorkQueueConfig wqConfig = {
+      .size = 4,
+      .foreground = true
+  };
+
+  WQ_DEFAULT = init(SimWorkQueue, &wqConfig);
+  assert(WQ_DEFAULT != NULL);
+}
+/*----------------------------------------------------------------------------*/
+void boardSetupLowPriorityWQ(void)
+{
+  static const struct SimWorkQueueConfig wqConfig = {
+      .size = 4
+  };
+
+  WQ_LP = init(SimWorkQueue, &wqConfig);
+  assert(WQ_LP != NULL);
+}
+/*----------------------------------------------------------------------------*/
+struct Interrupt *boardSetupButton(enum InputEvent)
+{
+  /* Button is never pressed, interrupt is raised by device models only */
+  return setupPeriodicEvent(0);
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupDisplayBus(void)
+{
+  static const struct SimBusConfig busConfig = {
+      .rate = 20000000,
+      .type = SIM_BUS_PARALLEL
+  };
+
+  struct Interface * const interface = init(SimBus, &busConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupFlash(void)
+{
+  /* W25Q128JV with typical program and erase times */
+  static const struct SimFlashConfig flashConfig = {
+      .path = "w25q128.bin",
+      .jedec = 0xEF4018,
+      .rate = 20000000,
+      .poll = 1000,
+      .program = 400,
+      .sector = 45000,
+      .block = 150000
+  };
+
+  struct Interface * const interface = init(SimFlash, &flashConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupI2C(void)
+{
+  static const struct SimBusConfig busConfig = {
+      .rate = 100000,
+      .type = SIM_BUS_I2C
+  };
+  static uint8_t eepromMemory[EEPROM_SIZE];
+  static const struct SimM24Config eepromConfig = {
+      .memory = eepromMemory,
+      .size = sizeof(eepromMemory),
+      .address = 0x50,
+      .cycle = 5000,
+      .page = 32
+  };
+  static const struct SimHMC5883Config magnetometerConfig = {
+      .address = 0x1E
+  };
+  static const struct SimMPU60XXConfig imuConfig = {
+      .address = 0x68
+  };
+  static const struct SimMS56XXConfig barometerConfig = {
+      .address = 0x77
+  };
+  static const struct SimSHT2XConfig hygrometerConfig = {
+      .address = 0x40
+  };
+  static struct SimM24 eeprom;
+  static struct SimHMC5883 magnetometer;
+  static struct SimMPU60XX imu;
+  static struct SimMS56XX barometer;
+  static struct SimSHT2X hygrometer;
+
+  struct Interface * const interface = init(SimBus, &busConfig);
+  assert(interface != NULL);
+
+  struct SimBus * const bus = (struct SimBus *)interface;
+
+  /* M24C512-like memory with the typical write cycle time */
+  simM24Init(&eeprom, &eepromConfig);
+  simBusAttach(bus, &eeprom.base);
+
+  /* Sensors use the default addresses of the examples */
+  simHMC5883Init(&magnetometer, &magnetometerConfig);
+  simBusAttach(bus, &magnetometer.base);
+  simMPU60XXInit(&imu, &imuConfig);
+  simBusAttach(bus, &imu.base);
+  simMS56XXInit(&barometer, &barometerConfig);
+  simBusAttach(bus, &barometer.base);
+  simSHT2XInit(&hygrometer, &hygrometerConfig);
+  simBusAttach(bus, &hygrometer.base);
+
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Interrupt *boardSetupSensorEvent0(enum InputEvent, enum PinPull)
+{
+  return setupPeriodicEvent(SENSOR_EVENT_PERIOD);
+}
+/*----------------------------------------------------------------------------*/
+struct Interrupt *boardSetupSensorEvent1(enum InputEvent, enum PinPull)
+{
+  return setupPeriodicEvent(SENSOR_EVENT_PERIOD);
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupSerial(void)
+{
+  static const struct SimSerialConfig serialConfig = {
+      .rxLength = BOARD_UART_BUFFER,
+      .txLength = BOARD_UART_BUFFER,
+      .rate = 19200,
+      .rx = STDIN_FILENO,
+      .tx = STDOUT_FILENO
+  };
+
+  struct Interface * const interface = init(SimSerial, &serialConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupSerialAux(void)
+{
+  static const struct SimSerialConfig serialConfig = {
+      .rxLength = BOARD_UART_BUFFER,
+      .txLength = BOARD_UART_BUFFER,
+      .rate = 19200,
+      .rx = -1,
+      .tx = STDERR_FILENO
+  };
+
+  struct Interface * const interface = init(SimSerial, &serialConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupSpi(void)
+{
+  static const struct SimBusConfig busConfig = {
+      .rate = 1000000,
+      .type = SIM_BUS_SPI
+  };
+
+  struct Interface * const interface = init(SimBus, &busConfig);
+  assert(interface != NULL);
+  return interface;
+}
+/*----------------------------------------------------------------------------*/
+struct Timer *boardSetupTimer(void)
+{
+  return setupTimer();
+}
+/*----------------------------------------------------------------------------*/
+struct Timer *boardSetupTimerAux0(void)
+{
+  return setupTimer();
+}
+/*----------------------------------------------------------------------------*/
+struct Timer *boardSetupTimerAux1(void)
+{
+  return setupTimer();
+}
+/*----------------------------------------------------------------------------*/
+struct Interrupt *boardSetupTouchEvent(enum InputEvent, enum PinPull)
+{
+  return setupPeriodicEvent(0);
+}
+/*----------------------------------------------------------------------------*/
+struct Interface *boardSetupWS281x(size_t)
+{
+  /* One bit of the color data per clock cycle at 800 kHz */
+  static const struct SimBusConfig busConfig = {
+      .rate = 800000,
+      .type = SIM_BUS_SPI
+  };
+
+  struct Interface * const interface = init(SimBus, &busConfig);
+  assert(interface != NULL);
+  return interface;
+}
@@ -0,0 +1,66 @@
+/*
+ * x86_default/shared/board.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_BOARD_H_
+#define X86_DEFAULT_SHARED_BOARD_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/pin.h>
+#include <halm/wq.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+#define BOARD_BUTTON            PIN(0, 0)
+#define BOARD_BUTTON_INV        true
+#define BOARD_LED_0             PIN(0, 1)
+#define BOARD_LED_1             PIN(0, 2)
+#define BOARD_LED_2             PIN(0, 3)
+#define BOARD_LED               BOARD_LED_0
+#define BOARD_LED_INV           false
+#define BOARD_SPI_CS            PIN(0, 4)
+#define BOARD_UART_BUFFER       512
+
+#define BOARD_DISPLAY_BL        PIN(0, 5)
+#define BOARD_DISPLAY_CS        PIN(0, 6)
+#define BOARD_DISPLAY_RESET     PIN(0, 7)
+#define BOARD_DISPLAY_RS        PIN(0, 8)
+#define BOARD_DISPLAY_RW        PIN(0, 9)
+
+#define BOARD_DISPLAY_SPI_BL    BOARD_DISPLAY_BL
+#define BOARD_DISPLAY_SPI_CS    BOARD_SPI_CS
+#define BOARD_DISPLAY_SPI_RESET PIN(0, 10)
+#define BOARD_DISPLAY_SPI_RS    PIN(0, 11)
+
+#define BOARD_TOUCH_CS          PIN(0, 12)
+#define BOARD_SENSOR_CS         BOARD_SPI_CS
+
+/* Work queue with its own thread, started without blocking the caller */
+extern struct WorkQueue *WQ_LP;
+/*----------------------------------------------------------------------------*/
+struct Interface;
+struct Interrupt;
+struct Timer;
+/*----------------------------------------------------------------------------*/
+void boardSetupClockExt(void);
+void boardSetupClockPll(void);
+void boardSetupDefaultWQ(void);
+void boardSetupLowPriorityWQ(void);
+struct Interrupt *boardSetupButton(enum InputEvent);
+struct Interface *boardSetupDisplayBus(void);
+struct Interface *boardSetupFlash(void);
+struct Interface *boardSetupI2C(void);
+struct Interrupt *boardSetupSensorEvent(enum InputEvent, enum PinPull);
+struct Interrupt *boardSetupSensorEvent0(enum InputEvent, enum PinPull);
+struct Interrupt *boardSetupSensorEvent1(enum InputEvent, enum PinPull);
+struct Interface *boardSetupSerial(void);
+struct Interface *boardSetupSerialAux(void);
+struct Interface *boardSetupSpi(void);
+struct Interface *boardSetupSpiDisplay(void);
+struct Timer *boardSetupTimer(void);
+struct Timer *boardSetupTimerAux0(void);
+struct Timer *boardSetupTimerAux1(void);
+struct Interrupt *boardSetupTouchEvent(enum InputEvent, enum PinPull);
+struct Interface *boardSetupWS281x(size_t);
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_BOARD_H_ */
@@ -0,0 +1,315 @@
+/*
+ * x86_default/shared/sim_bus.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_bus.h"
+#include <halm/generic/i2c.h>
+#include <halm/generic/spi.h>
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static uint64_t calcTransferTime(const struct SimBus *, size_t);
+static void finishTransfer(struct SimBus *, struct SimDevice *, size_t,
+    enum Result);
+static struct SimDevice *findDevice(const struct SimBus *);
+static void onTransferCompleted(void *);
+static void stopTransfer(struct SimBus *);
+
+static enum Result busInit(void *, const void *);
+static void busDeinit(void *);
+static void busSetCallback(void *, void (*)(void *), void *);
+static enum Result busGetParam(void *, int, void *);
+static enum Result busSetParam(void *, int, const void *);
+static size_t busRead(void *, void *, size_t);
+static size_t busWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const SimBus = &(const struct InterfaceClass){
+    .size = sizeof(struct SimBus),
+    .init = busInit,
+    .deinit = busDeinit,
+
+    .setCallback = busSetCallback,
+    .getParam = busGetParam,
+    .setParam = busSetParam,
+    .read = busRead,
+    .write = busWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t calcTransferTime(const struct SimBus *interface, size_t length)
+{
+  uint64_t cycles;
+
+  switch (interface->type)
+  {
+    case SIM_BUS_I2C:
+      /* Start and stop conditions, address byte and data bytes with ACK */
+      cycles = 2 + 9 * (uint64_t)(length + 1);
+      break;
+
+    case SIM_BUS_SPI:
+      cycles = 8 * (uint64_t)length;
+      break;
+
+    default:
+      cycles = (uint64_t)length;
+      break;
+  }
+
+  return cycles * 1000000000 / interface->rate;
+}
+/*----------------------------------------------------------------------------*/
+static void finishTransfer(struct SimBus *interface, struct SimDevice *device,
+    size_t length, enum Result status)
+{
+  const uint64_t time = calcTransferTime(interface, length);
+
+  interface->bytes += length;
+  interface->busy += time;
+
+  /* Transaction continues after the repeated start condition */
+  interface->active = interface->repeated ? NULL : device;
+  interface->repeated = false;
+
+  if (interface->blocking)
+  {
+    simWait(time);
+    stopTransfer(interface);
+    interface->status = status;
+  }
+  else
+  {
+    interface->pending = status;
+    interface->status = E_BUSY;
+    simEventSchedule(&interface->event, time);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static struct SimDevice *findDevice(const struct SimBus *interface)
+{
+  for (struct SimDevice *device = interface->devices; device != NULL;
+      device = device->next)
+  {
+    if (interface->type != SIM_BUS_I2C)
+      return device;
+
+    if (device->address == interface->address)
+    {
+      /* Busy devices do not acknowledge their address */
+      if (device->type->select != NULL && !device->type->select(device))
+        return NULL;
+
+      return device;
+    }
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static void onTransferCompleted(void *object)
+{
+  struct SimBus * const interface = object;
+
+  stopTransfer(interface);
+  interface->status = interface->pending;
+
+  if (interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void stopTransfer(struct SimBus *interface)
+{
+  struct SimDevice * const device = interface->active;
+
+  interface->active = NULL;
+
+  if (device != NULL && device->type->stop != NULL)
+    device->type->stop(device);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result busInit(void *object, const void *configBase)
+{
+  const struct SimBusConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->rate > 0);
+
+  struct SimBus * const interface = object;
+
+  simEventInit(&interface->event, onTransferCompleted, interface);
+
+  interface->callback = NULL;
+  interface->devices = NULL;
+  interface->active = NULL;
+  interface->bytes = 0;
+  interface->busy = 0;
+  interface->address = 0;
+  interface->rate = config->rate;
+  interface->pending = E_OK;
+  interface->status = E_OK;
+  interface->type = config->type;
+  interface->blocking = true;
+  interface->locked = false;
+  interface->repeated = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void busDeinit(void *object)
+{
+  struct SimBus * const interface = object;
+  simEventCancel(&interface->event);
+}
+/*----------------------------------------------------------------------------*/
+static void busSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimBus * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result busGetParam(void *object, int parameter, void *data)
+{
+  struct SimBus * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_ADDRESS:
+      *(uint32_t *)data = interface->address;
+      return E_OK;
+
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      return E_OK;
+
+    case IF_STATUS:
+      return interface->status;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result busSetParam(void *object, int parameter, const void *data)
+{
+  struct SimBus * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_I2C_BUS_RECOVERY:
+      interface->status = E_OK;
+      return E_OK;
+
+    case IF_I2C_REPEATED_START:
+      interface->repeated = true;
+      return E_OK;
+
+    case IF_SPI_BIDIRECTIONAL:
+    case IF_SPI_MODE:
+    case IF_SPI_UNIDIRECTIONAL:
+      return interface->type == SIM_BUS_SPI ? E_OK : E_INVALID;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_ACQUIRE:
+    {
+      bool locked;
+
+      simIrqLock();
+      locked = interface->locked;
+      interface->locked = true;
+      simIrqUnlock();
+
+      return locked ? E_BUSY : E_OK;
+    }
+
+    case IF_RELEASE:
+      interface->locked = false;
+      return E_OK;
+
+    case IF_ADDRESS:
+      interface->address = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_BLOCKING:
+      interface->blocking = true;
+      return E_OK;
+
+    case IF_RATE:
+      if (!*(const uint32_t *)data)
+        return E_VALUE;
+
+      interface->rate = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      interface->blocking = false;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t busRead(void *object, void *buffer, size_t length)
+{
+  struct SimBus * const interface = object;
+  struct SimDevice * const device = findDevice(interface);
+  size_t count;
+
+  if (device != NULL)
+  {
+    count = device->type->read(device, buffer, length);
+  }
+  else if (interface->type == SIM_BUS_I2C)
+  {
+    /* No device at the selected address or the device is busy */
+    finishTransfer(interface, NULL, 0, E_ADDRESS);
+    return interface->blocking ? 0 : length;
+  }
+  else
+  {
+    /* Floating data lines */
+    memset(buffer, 0xFF, length);
+    count = length;
+  }
+
+  finishTransfer(interface, device, count, E_OK);
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t busWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimBus * const interface = object;
+  struct SimDevice * const device = findDevice(interface);
+  size_t count;
+
+  if (device != NULL)
+  {
+    count = device->type->write(device, buffer, length);
+  }
+  else if (interface->type == SIM_BUS_I2C)
+  {
+    finishTransfer(interface, NULL, 0, E_ADDRESS);
+    return interface->blocking ? 0 : length;
+  }
+  else
+  {
+    count = length;
+  }
+
+  finishTransfer(interface, device, count, E_OK);
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+void simBusAttach(struct SimBus *interface, struct SimDevice *device)
+{
+  device->next = interface->devices;
+  interface->devices = device;
+}
@@ -0,0 +1,95 @@
+/*
+ * x86_default/shared/sim_bus.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_BUS_H_
+#define X86_DEFAULT_SHARED_SIM_BUS_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_core.h"
+#include <xcore/interface.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const SimBus;
+
+enum [[gnu::packed]] SimBusType
+{
+  /* Addressed bus, 9 clock cycles per byte, unknown addresses are NACKed */
+  SIM_BUS_I2C,
+  /* Single device bus, 8 clock cycles per byte */
+  SIM_BUS_SPI,
+  /* Parallel bus, one clock cycle per byte */
+  SIM_BUS_PARALLEL
+};
+
+struct SimDevice;
+
+struct SimDeviceClass
+{
+  /* Device transfer handlers, return number of bytes acknowledged */
+  size_t (*read)(struct SimDevice *, void *, size_t);
+  size_t (*write)(struct SimDevice *, const void *, size_t);
+  /* Optional: address phase, returns false when the address is NACKed */
+  bool (*select)(struct SimDevice *);
+  /* Optional: end of the transaction, called after the stop condition */
+  void (*stop)(struct SimDevice *);
+};
+
+struct SimDevice
+{
+  const struct SimDeviceClass *type;
+  struct SimDevice *next;
+  uint32_t address;
+};
+
+struct SimBusConfig
+{
+  /** Mandatory: default clock rate. */
+  uint32_t rate;
+  /** Mandatory: bus type. */
+  enum SimBusType type;
+};
+
+struct SimBus
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Attached device models */
+  struct SimDevice *devices;
+  /* Device waiting for the end of the transfer in progress */
+  struct SimDevice *active;
+  /* Transfer completion event for zero-copy mode */
+  struct SimEvent event;
+
+  /* Total number of bytes transferred */
+  uint64_t bytes;
+  /* Total transfer time in nanoseconds */
+  uint64_t busy;
+
+  /* Device address */
+  uint32_t address;
+  /* Current clock rate */
+  uint32_t rate;
+  /* Status of the transfer in progress */
+  enum Result pending;
+  /* Status of the last transfer */
+  enum Result status;
+  /* Bus type */
+  enum SimBusType type;
+
+  bool blocking;
+  bool locked;
+  bool repeated;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simBusAttach(struct SimBus *, struct SimDevice *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_BUS_H_ */
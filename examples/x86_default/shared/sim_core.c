@@ -0,0 +1,196 @@
+/*
+ * x86_default/shared/sim_core.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_core.h"
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+struct SimScheduler
+{
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t update;
+
+  /* Events sorted by deadline in ascending order */
+  struct SimEvent *head;
+};
+/*----------------------------------------------------------------------------*/
+static void *eventThread(void *);
+static void schedulerInit(void);
+static void unlinkEvent(struct SimEvent *);
+/*----------------------------------------------------------------------------*/
+static pthread_once_t schedulerOnce = PTHREAD_ONCE_INIT;
+static struct SimScheduler scheduler;
+static pthread_mutex_t irqLock;
+/*----------------------------------------------------------------------------*/
+static void *eventThread(void *)
+{
+  pthread_mutex_lock(&scheduler.lock);
+
+  while (1)
+  {
+    struct SimEvent * const event = scheduler.head;
+
+    if (event == NULL)
+    {
+      pthread_cond_wait(&scheduler.update, &scheduler.lock);
+      continue;
+    }
+
+    const uint64_t current = simTime();
+
+    if (event->deadline > current)
+    {
+      const struct timespec timeout = {
+          .tv_sec = (time_t)(event->deadline / 1000000000),
+          .tv_nsec = (long)(event->deadline % 1000000000)
+      };
+
+      pthread_cond_timedwait(&scheduler.update, &scheduler.lock, &timeout);
+      continue;
+    }
+
+    unlinkEvent(event);
+
+    void (*callback)(void *) = event->callback;
+    void * const argument = event->argument;
+
+    /* Callbacks may reschedule events, release the scheduler first */
+    pthread_mutex_unlock(&scheduler.lock);
+
+    simIrqLock();
+    callback(argument);
+    simIrqUnlock();
+
+    pthread_mutex_lock(&scheduler.lock);
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static void schedulerInit(void)
+{
+  pthread_condattr_t conditionAttributes;
+  pthread_mutexattr_t mutexAttributes;
+  int res;
+
+  pthread_mutexattr_init(&mutexAttributes);
+  pthread_mutexattr_settype(&mutexAttributes, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&irqLock, &mutexAttributes);
+  pthread_mutexattr_destroy(&mutexAttributes);
+
+  pthread_condattr_init(&conditionAttributes);
+  pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC);
+  pthread_cond_init(&scheduler.update, &conditionAttributes);
+  pthread_condattr_destroy(&conditionAttributes);
+
+  pthread_mutex_init(&scheduler.lock, NULL);
+  scheduler.head = NULL;
+
+  res = pthread_create(&scheduler.thread, NULL, eventThread, NULL);
+  assert(res == 0);
+  (void)res;
+}
+/*----------------------------------------------------------------------------*/
+static void unlinkEvent(struct SimEvent *event)
+{
+  struct SimEvent **current = &scheduler.head;
+
+  while (*current != NULL)
+  {
+    if (*current == event)
+    {
+      *current = event->next;
+      break;
+    }
+
+    current = &(*current)->next;
+  }
+
+  event->next = NULL;
+  event->queued = false;
+}
+/*----------------------------------------------------------------------------*/
+void simEventCancel(struct SimEvent *event)
+{
+  pthread_once(&schedulerOnce, schedulerInit);
+
+  pthread_mutex_lock(&scheduler.lock);
+  if (event->queued)
+    unlinkEvent(event);
+  pthread_mutex_unlock(&scheduler.lock);
+}
+/*----------------------------------------------------------------------------*/
+void simEventInit(struct SimEvent *event, void (*callback)(void *),
+    void *argument)
+{
+  event->next = NULL;
+  event->callback = callback;
+  event->argument = argument;
+  event->deadline = 0;
+  event->queued = false;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Schedule an event for delivery from the simulated interrupt context.
+ * @param event Event descriptor, the descriptor will be rescheduled
+ * when it is already queued.
+ * @param delay Delay in nanoseconds relative to the current time.
+ */
+void simEventSchedule(struct SimEvent *event, uint64_t delay)
+{
+  pthread_once(&schedulerOnce, schedulerInit);
+
+  pthread_mutex_lock(&scheduler.lock);
+
+  if (event->queued)
+    unlinkEvent(event);
+
+  struct SimEvent **current = &scheduler.head;
+
+  event->deadline = simTime() + delay;
+  while (*current != NULL && (*current)->deadline <= event->deadline)
+    current = &(*current)->next;
+
+  event->next = *current;
+  event->queued = true;
+  *current = event;
+
+  pthread_cond_signal(&scheduler.update);
+  pthread_mutex_unlock(&scheduler.lock);
+}
+/*----------------------------------------------------------------------------*/
+void simIrqLock(void)
+{
+  pthread_once(&schedulerOnce, schedulerInit);
+  pthread_mutex_lock(&irqLock);
+}
+/*----------------------------------------------------------------------------*/
+void simIrqUnlock(void)
+{
+  pthread_mutex_unlock(&irqLock);
+}
+/*----------------------------------------------------------------------------*/
+uint64_t simTime(void)
+{
+  struct timespec current;
+
+  clock_gettime(CLOCK_MONOTONIC, &current);
+  return (uint64_t)current.tv_sec * 1000000000 + (uint64_t)current.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+void simWait(uint64_t delay)
+{
+  struct timespec remaining = {
+      .tv_sec = (time_t)(delay / 1000000000),
+      .tv_nsec = (long)(delay % 1000000000)
+  };
+
+  while (nanosleep(&remaining, &remaining) == -1 && errno == EINTR);
+}
@@ -0,0 +1,35 @@
+/*
+ * x86_default/shared/sim_core.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_CORE_H_
+#define X86_DEFAULT_SHARED_SIM_CORE_H_
+/*----------------------------------------------------------------------------*/
+#include <xcore/helpers.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*----------------------------------------------------------------------------*/
+struct SimEvent
+{
+  struct SimEvent *next;
+  void (*callback)(void *);
+  void *argument;
+  uint64_t deadline;
+  bool queued;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simEventCancel(struct SimEvent *);
+void simEventInit(struct SimEvent *, void (*)(void *), void *);
+void simEventSchedule(struct SimEvent *, uint64_t);
+void simIrqLock(void);
+void simIrqUnlock(void);
+uint64_t simTime(void);
+void simWait(uint64_t);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_CORE_H_ */
@@ -0,0 +1,376 @@
+/*
+ * x86_default/shared/sim_flash.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_flash.h"
+#include <halm/generic/flash.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+/* Fast Read: command, 24-bit address and dummy byte */
+#define READ_HEADER_LENGTH    5
+/* Page Program and erase commands: command and 24-bit address */
+#define WRITE_HEADER_LENGTH   4
+/* Read Status Register: command and status byte */
+#define STATUS_LENGTH         2
+
+#define BLOCK_SIZE            65536
+#define PAGE_SIZE             256
+#define SECTOR_SIZE           4096
+/*----------------------------------------------------------------------------*/
+static uint64_t calcBusyTime(const struct SimFlash *, uint64_t);
+static uint64_t calcTransferTime(const struct SimFlash *, size_t);
+static enum Result eraseRegion(struct SimFlash *, uint32_t, uint32_t,
+    uint64_t);
+static bool mapMemory(struct SimFlash *, const char *);
+static void onOperationCompleted(void *);
+static void startOperation(struct SimFlash *, enum SimFlashState, uint64_t);
+
+static enum Result flashInit(void *, const void *);
+static void flashDeinit(void *);
+static void flashSetCallback(void *, void (*)(void *), void *);
+static enum Result flashGetParam(void *, int, void *);
+static enum Result flashSetParam(void *, int, const void *);
+static size_t flashRead(void *, void *, size_t);
+static size_t flashWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const SimFlash = &(const struct InterfaceClass){
+    .size = sizeof(struct SimFlash),
+    .init = flashInit,
+    .deinit = flashDeinit,
+
+    .setCallback = flashSetCallback,
+    .getParam = flashGetParam,
+    .setParam = flashSetParam,
+    .read = flashRead,
+    .write = flashWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t calcBusyTime(const struct SimFlash *interface, uint64_t time)
+{
+  if (!time)
+    return 0;
+
+  /* Busy flag is observed on the first status read after the operation */
+  const uint64_t polls = interface->poll ?
+      (time + interface->poll - 1) / interface->poll : 1;
+  const uint64_t period = interface->poll ? interface->poll : time;
+
+  return polls * period + polls * calcTransferTime(interface, STATUS_LENGTH);
+}
+/*----------------------------------------------------------------------------*/
+static uint64_t calcTransferTime(const struct SimFlash *interface,
+    size_t length)
+{
+  return (uint64_t)length * 8 * 1000000000 / interface->rate;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result eraseRegion(struct SimFlash *interface, uint32_t position,
+    uint32_t size, uint64_t time)
+{
+  if (interface->state != SIM_FLASH_IDLE)
+    return E_BUSY;
+  if (position >= interface->size || position % size)
+    return E_ADDRESS;
+
+  memset(interface->memory + position, 0xFF, size);
+  interface->erased += size;
+
+  startOperation(interface, SIM_FLASH_ERASE,
+      calcTransferTime(interface, WRITE_HEADER_LENGTH)
+      + calcBusyTime(interface, time));
+
+  /* Completion of the erase is signaled with the callback */
+  return interface->blocking ? E_OK : E_BUSY;
+}
+/*----------------------------------------------------------------------------*/
+static bool mapMemory(struct SimFlash *interface, const char *path)
+{
+  const int file = open(path, O_RDWR | O_CREAT, 0644);
+  struct stat info;
+
+  if (file < 0)
+    return false;
+
+  if (fstat(file, &info) != 0)
+  {
+    close(file);
+    return false;
+  }
+
+  const off_t length = info.st_size;
+
+  if (length < (off_t)interface->size
+      && ftruncate(file, (off_t)interface->size) != 0)
+  {
+    close(file);
+    return false;
+  }
+
+  void * const memory = mmap(NULL, interface->size, PROT_READ | PROT_WRITE,
+      MAP_SHARED, file, 0);
+
+  /* Mapping stays valid after the descriptor is closed */
+  close(file);
+
+  if (memory == MAP_FAILED)
+    return false;
+
+  interface->memory = memory;
+
+  /* New part of the backing file is in the erased state */
+  if (length < (off_t)interface->size)
+  {
+    memset(interface->memory + length, 0xFF,
+        interface->size - (size_t)length);
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void onOperationCompleted(void *object)
+{
+  struct SimFlash * const interface = object;
+
+  interface->state = SIM_FLASH_IDLE;
+  interface->status = E_OK;
+
+  if (interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void startOperation(struct SimFlash *interface,
+    enum SimFlashState state, uint64_t time)
+{
+  /*
+   * The memory array is updated immediately, so the contents are
+   * consistent when the operation completes. Only the busy time is modeled.
+   */
+  if (interface->blocking)
+  {
+    simWait(time);
+    interface->status = E_OK;
+  }
+  else
+  {
+    interface->state = state;
+    interface->status = E_BUSY;
+    simEventSchedule(&interface->event, time);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flashInit(void *object, const void *configBase)
+{
+  const struct SimFlashConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->path != NULL);
+  assert(config->rate > 0);
+
+  struct SimFlash * const interface = object;
+  const uint8_t capacity = (uint8_t)config->jedec;
+
+  /* Capacity byte of the JEDEC ID is a binary logarithm of the size */
+  if (capacity < 16 || capacity > 24)
+    return E_VALUE;
+
+  interface->size = 1UL << capacity;
+  if (!mapMemory(interface, config->path))
+    return E_ERROR;
+
+  simEventInit(&interface->event, onOperationCompleted, interface);
+
+  interface->callback = NULL;
+  interface->block = (uint64_t)config->block * 1000;
+  interface->poll = (uint64_t)config->poll * 1000;
+  interface->program = (uint64_t)config->program * 1000;
+  interface->sector = (uint64_t)config->sector * 1000;
+  interface->rate = config->rate;
+
+  interface->erased = 0;
+  interface->programmed = 0;
+  interface->read = 0;
+  interface->conflicts = 0;
+
+  interface->jedec = config->jedec;
+  interface->position = 0;
+  interface->status = E_OK;
+  interface->state = SIM_FLASH_IDLE;
+  interface->blocking = true;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void flashDeinit(void *object)
+{
+  struct SimFlash * const interface = object;
+
+  simEventCancel(&interface->event);
+  munmap(interface->memory, interface->size);
+}
+/*----------------------------------------------------------------------------*/
+static void flashSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimFlash * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flashGetParam(void *object, int parameter, void *data)
+{
+  struct SimFlash * const interface = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_BLOCK_SIZE:
+      *(uint32_t *)data = BLOCK_SIZE;
+      return E_OK;
+
+    case IF_FLASH_PAGE_SIZE:
+      *(uint32_t *)data = PAGE_SIZE;
+      return E_OK;
+
+    case IF_FLASH_SECTOR_SIZE:
+      *(uint32_t *)data = SECTOR_SIZE;
+      return E_OK;
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_POSITION:
+      *(uint32_t *)data = interface->position;
+      return E_OK;
+
+    case IF_POSITION_64:
+      *(uint64_t *)data = interface->position;
+      return E_OK;
+
+    case IF_SIZE:
+      *(uint32_t *)data = interface->size;
+      return E_OK;
+
+    case IF_SIZE_64:
+      *(uint64_t *)data = interface->size;
+      return E_OK;
+
+    case IF_STATUS:
+      return interface->status;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static enum Result flashSetParam(void *object, int parameter, const void *data)
+{
+  struct SimFlash * const interface = object;
+
+  switch ((enum FlashParameter)parameter)
+  {
+    case IF_FLASH_ERASE_BLOCK:
+      return eraseRegion(interface, *(const uint32_t *)data, BLOCK_SIZE,
+          interface->block);
+
+    case IF_FLASH_ERASE_SECTOR:
+      return eraseRegion(interface, *(const uint32_t *)data, SECTOR_SIZE,
+          interface->sector);
+
+    default:
+      break;
+  }
+
+  switch ((enum IfParameter)parameter)
+  {
+    case IF_BLOCKING:
+      interface->blocking = true;
+      return E_OK;
+
+    case IF_POSITION:
+      if (*(const uint32_t *)data >= interface->size)
+        return E_ADDRESS;
+
+      interface->position = *(const uint32_t *)data;
+      return E_OK;
+
+    case IF_POSITION_64:
+      if (*(const uint64_t *)data >= interface->size)
+        return E_ADDRESS;
+
+      interface->position = (uint32_t)*(const uint64_t *)data;
+      return E_OK;
+
+    case IF_ZEROCOPY:
+      interface->blocking = false;
+      return E_OK;
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t flashRead(void *object, void *buffer, size_t length)
+{
+  struct SimFlash * const interface = object;
+
+  if (interface->state != SIM_FLASH_IDLE)
+    return 0;
+
+  length = MIN(length, interface->size - interface->position);
+  memcpy(buffer, interface->memory + interface->position, length);
+  interface->position += length;
+  interface->read += length;
+
+  startOperation(interface, SIM_FLASH_READ,
+      calcTransferTime(interface, READ_HEADER_LENGTH + length));
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static size_t flashWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimFlash * const interface = object;
+  const uint8_t *input = buffer;
+  uint64_t time = 0;
+
+  if (interface->state != SIM_FLASH_IDLE)
+    return 0;
+
+  length = MIN(length, interface->size - interface->position);
+
+  /* Data is split into page program commands on page boundaries */
+  for (size_t offset = 0; offset < length;)
+  {
+    uint8_t * const page = interface->memory + interface->position;
+    const size_t chunk = MIN(length - offset,
+        PAGE_SIZE - interface->position % PAGE_SIZE);
+
+    for (size_t i = 0; i < chunk; ++i)
+    {
+      /* Programming can only clear bits */
+      if ((page[i] & input[offset + i]) != input[offset + i])
+        ++interface->conflicts;
+
+      page[i] &= input[offset + i];
+    }
+
+    time += calcTransferTime(interface, WRITE_HEADER_LENGTH + chunk)
+        + calcBusyTime(interface, interface->program);
+
+    interface->position += chunk;
+    offset += chunk;
+  }
+
+  interface->programmed += length;
+
+  startOperation(interface, SIM_FLASH_PROGRAM, time);
+  return length;
+}
@@ -0,0 +1,80 @@
+/*
+ * x86_default/shared/sim_flash.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_FLASH_H_
+#define X86_DEFAULT_SHARED_SIM_FLASH_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_core.h"
+#include <xcore/interface.h>
+#include <stddef.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const SimFlash;
+
+enum [[gnu::packed]] SimFlashState
+{
+  SIM_FLASH_IDLE,
+  SIM_FLASH_ERASE,
+  SIM_FLASH_PROGRAM,
+  SIM_FLASH_READ
+};
+
+struct SimFlashConfig
+{
+  /** Mandatory: backing file, it is created when missing. */
+  const char *path;
+  /** Mandatory: JEDEC ID, memory size is derived from the capacity byte. */
+  uint32_t jedec;
+  /** Mandatory: serial clock rate. */
+  uint32_t rate;
+  /** Mandatory: status register polling period in microseconds. */
+  uint32_t poll;
+  /** Mandatory: page program time in microseconds. */
+  uint32_t program;
+  /** Mandatory: 4 KiB sector erase time in microseconds. */
+  uint32_t sector;
+  /** Mandatory: 64 KiB block erase time in microseconds. */
+  uint32_t block;
+};
+
+struct SimFlash
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Memory array mapped from the backing file */
+  uint8_t *memory;
+  uint32_t size;
+
+  /* Operation completion event for zero-copy mode */
+  struct SimEvent event;
+
+  /* Timing model in nanoseconds */
+  uint64_t block;
+  uint64_t poll;
+  uint64_t program;
+  uint64_t sector;
+  uint32_t rate;
+
+  /* Statistics */
+  unsigned long erased;
+  unsigned long programmed;
+  unsigned long read;
+  /* Number of bytes where programming tried to set cleared bits */
+  unsigned long conflicts;
+
+  uint32_t jedec;
+  uint32_t position;
+
+  /* Status of the last operation */
+  enum Result status;
+  enum SimFlashState state;
+
+  bool blocking;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_FLASH_H_ */
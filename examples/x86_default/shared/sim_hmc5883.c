@@ -0,0 +1,143 @@
+/*
+ * x86_default/shared/sim_hmc5883.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_hmc5883.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define REG_CONFIG_A  0
+#define REG_CONFIG_B  1
+#define REG_MODE      2
+#define REG_DATA_X_H  3
+#define REG_DATA_Y_L  8
+#define REG_STATUS    9
+#define REG_ID_A      10
+
+#define STATUS_RDY    0x01
+
+/* Magnetic field vector in milligauss */
+#define FIELD_X       200
+#define FIELD_Y       0
+#define FIELD_Z       (-400)
+/*----------------------------------------------------------------------------*/
+static void deviceSample(struct SimHMC5883 *);
+static size_t deviceRead(struct SimDevice *, void *, size_t);
+static bool deviceSelect(struct SimDevice *);
+static size_t deviceWrite(struct SimDevice *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct SimDeviceClass deviceTable = {
+    .read = deviceRead,
+    .write = deviceWrite,
+    .select = deviceSelect,
+    .stop = NULL
+};
+/* Resolution in LSB per gauss for each gain setting */
+static const int16_t gainTable[] = {
+    1370, 1090, 820, 660, 440, 390, 330, 230
+};
+/*----------------------------------------------------------------------------*/
+static void deviceSample(struct SimHMC5883 *device)
+{
+  const int32_t gain = gainTable[device->registers[REG_CONFIG_B] >> 5];
+  /* Output registers are ordered as X, Z, Y */
+  const int16_t values[] = {
+      (int16_t)(FIELD_X * gain / 1000),
+      (int16_t)(FIELD_Z * gain / 1000),
+      (int16_t)(FIELD_Y * gain / 1000)
+  };
+  uint8_t *output = device->registers + REG_DATA_X_H;
+
+  /* Output registers are big-endian */
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+  {
+    *output++ = (uint8_t)((uint16_t)values[i] >> 8);
+    *output++ = (uint8_t)values[i];
+  }
+
+  device->registers[REG_STATUS] = STATUS_RDY;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *object, void *buffer, size_t length)
+{
+  struct SimHMC5883 * const device = (struct SimHMC5883 *)object;
+  uint8_t *output = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    output[i] = device->registers[device->pointer];
+
+    /* Address pointer rolls back from the last output register */
+    if (device->pointer == REG_DATA_Y_L)
+      device->pointer = REG_DATA_X_H;
+    else if (++device->pointer == SIM_HMC5883_REGISTERS)
+      device->pointer = 0;
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static bool deviceSelect(struct SimDevice *object)
+{
+  struct SimHMC5883 * const device = (struct SimHMC5883 *)object;
+
+  /* Every transaction observes a new measurement */
+  deviceSample(device);
+
+  device->received = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceWrite(struct SimDevice *object, const void *buffer,
+    size_t length)
+{
+  struct SimHMC5883 * const device = (struct SimHMC5883 *)object;
+  const uint8_t *input = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (!device->received)
+    {
+      device->pointer = input[i] < SIM_HMC5883_REGISTERS ? input[i] : 0;
+      device->received = 1;
+      continue;
+    }
+
+    /* Only configuration and mode registers are writable */
+    if (device->pointer <= REG_MODE)
+      device->registers[device->pointer] = input[i];
+
+    if (++device->pointer == SIM_HMC5883_REGISTERS)
+      device->pointer = 0;
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the magnetometer model. Sensor measures a constant field,
+ * registers hold their power-on values.
+ * @param device Pointer to a device object.
+ * @param config Pointer to a configuration structure.
+ */
+void simHMC5883Init(struct SimHMC5883 *device,
+    const struct SimHMC5883Config *config)
+{
+  assert(config != NULL);
+
+  device->base.type = &deviceTable;
+  device->base.next = NULL;
+  device->base.address = config->address;
+
+  device->registers[REG_CONFIG_A] = 0x10;
+  device->registers[REG_CONFIG_B] = 0x20;
+  device->registers[REG_MODE] = 0x01;
+  device->registers[REG_ID_A + 0] = 'H';
+  device->registers[REG_ID_A + 1] = '4';
+  device->registers[REG_ID_A + 2] = '3';
+  deviceSample(device);
+
+  device->pointer = 0;
+  device->received = 0;
+}
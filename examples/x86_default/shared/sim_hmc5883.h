@@ -0,0 +1,39 @@
+/*
+ * x86_default/shared/sim_hmc5883.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_HMC5883_H_
+#define X86_DEFAULT_SHARED_SIM_HMC5883_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_bus.h"
+/*----------------------------------------------------------------------------*/
+/* Number of registers of the device */
+#define SIM_HMC5883_REGISTERS 13
+
+struct SimHMC5883Config
+{
+  /** Mandatory: device address on the bus. */
+  uint32_t address;
+};
+
+struct SimHMC5883
+{
+  struct SimDevice base;
+
+  /* Register file */
+  uint8_t registers[SIM_HMC5883_REGISTERS];
+  /* Register address counter */
+  uint8_t pointer;
+  /* Number of bytes received in the current transaction */
+  uint8_t received;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simHMC5883Init(struct SimHMC5883 *, const struct SimHMC5883Config *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_HMC5883_H_ */
@@ -0,0 +1,92 @@
+/*
+ * x86_default/shared/sim_interrupt.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_interrupt.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+static void onPeriodicEvent(void *);
+
+static enum Result intInit(void *, const void *);
+static void intDeinit(void *);
+static void intEnable(void *);
+static void intDisable(void *);
+static void intSetCallback(void *, void (*)(void *), void *);
+/*----------------------------------------------------------------------------*/
+const struct InterruptClass * const SimInterrupt =
+    &(const struct InterruptClass){
+    .size = sizeof(struct SimInterrupt),
+    .init = intInit,
+    .deinit = intDeinit,
+
+    .enable = intEnable,
+    .disable = intDisable,
+    .setCallback = intSetCallback
+};
+/*----------------------------------------------------------------------------*/
+static void onPeriodicEvent(void *object)
+{
+  struct SimInterrupt * const interrupt = object;
+
+  simEventSchedule(&interrupt->event, interrupt->period);
+  simInterruptRaise(interrupt);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result intInit(void *object, const void *configBase)
+{
+  const struct SimInterruptConfig * const config = configBase;
+  struct SimInterrupt * const interrupt = object;
+
+  simEventInit(&interrupt->event, onPeriodicEvent, interrupt);
+
+  interrupt->callback = NULL;
+  interrupt->period = config != NULL ? config->period : 0;
+  interrupt->enabled = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void intDeinit(void *object)
+{
+  struct SimInterrupt * const interrupt = object;
+  simEventCancel(&interrupt->event);
+}
+/*----------------------------------------------------------------------------*/
+static void intEnable(void *object)
+{
+  struct SimInterrupt * const interrupt = object;
+
+  interrupt->enabled = true;
+
+  if (interrupt->period)
+    simEventSchedule(&interrupt->event, interrupt->period);
+}
+/*----------------------------------------------------------------------------*/
+static void intDisable(void *object)
+{
+  struct SimInterrupt * const interrupt = object;
+
+  interrupt->enabled = false;
+  simEventCancel(&interrupt->event);
+}
+/*----------------------------------------------------------------------------*/
+static void intSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimInterrupt * const interrupt = object;
+
+  interrupt->callbackArgument = argument;
+  interrupt->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+void simInterruptRaise(struct SimInterrupt *interrupt)
+{
+  simIrqLock();
+
+  if (interrupt->enabled && interrupt->callback != NULL)
+    interrupt->callback(interrupt->callbackArgument);
+
+  simIrqUnlock();
+}
@@ -0,0 +1,45 @@
+/*
+ * x86_default/shared/sim_interrupt.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_INTERRUPT_H_
+#define X86_DEFAULT_SHARED_SIM_INTERRUPT_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_core.h"
+#include <halm/interrupt.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterruptClass * const SimInterrupt;
+
+struct SimInterruptConfig
+{
+  /**
+   * Optional: period of the event source in nanoseconds. Zero value
+   * configures an interrupt that is raised by device models only.
+   */
+  uint64_t period;
+};
+
+struct SimInterrupt
+{
+  struct Interrupt base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Periodic event descriptor */
+  struct SimEvent event;
+  /* Period of the event source */
+  uint64_t period;
+
+  bool enabled;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simInterruptRaise(struct SimInterrupt *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_INTERRUPT_H_ */
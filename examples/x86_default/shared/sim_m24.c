@@ -0,0 +1,166 @@
+/*
+ * x86_default/shared/sim_m24.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_m24.h"
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *, void *, size_t);
+static bool deviceSelect(struct SimDevice *);
+static void deviceStop(struct SimDevice *);
+static size_t deviceWrite(struct SimDevice *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct SimDeviceClass deviceTable = {
+    .read = deviceRead,
+    .write = deviceWrite,
+    .select = deviceSelect,
+    .stop = deviceStop
+};
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *object, void *buffer, size_t length)
+{
+  struct SimM24 * const device = (struct SimM24 *)object;
+  uint8_t *output = buffer;
+
+  /* Sequential read rolls over from the end of the memory to its start */
+  for (size_t i = 0; i < length; ++i)
+  {
+    output[i] = device->memory[device->pointer];
+    device->pointer = (device->pointer + 1) & (device->size - 1);
+  }
+
+  device->read += length;
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static bool deviceSelect(struct SimDevice *object)
+{
+  struct SimM24 * const device = (struct SimM24 *)object;
+
+  /* Device address is not acknowledged during the internal write cycle */
+  if (simTime() < device->ready)
+  {
+    ++device->polls;
+    return false;
+  }
+
+  device->received = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static void deviceStop(struct SimDevice *object)
+{
+  struct SimM24 * const device = (struct SimM24 *)object;
+
+  if (device->latched)
+  {
+    uint32_t column = device->column;
+
+    /* Only latched bytes are programmed, the rest of the page is kept */
+    for (size_t i = 0; i < device->latched; ++i)
+    {
+      device->memory[device->start + column] = device->latch[column];
+      column = (column + 1) & (device->page - 1);
+    }
+
+    device->written += device->latched;
+    device->latched = 0;
+    ++device->cycles;
+
+    /* Write cycle starts on the stop condition */
+    device->ready = simTime() + device->cycle;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceWrite(struct SimDevice *object, const void *buffer,
+    size_t length)
+{
+  struct SimM24 * const device = (struct SimM24 *)object;
+  const uint8_t *input = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (device->received < device->width)
+    {
+      /* Address bytes, most significant byte first */
+      if (!device->received)
+        device->pointer = 0;
+
+      device->pointer = ((device->pointer << 8) | input[i])
+          & (device->size - 1);
+
+      if (++device->received == device->width)
+      {
+        device->column = (uint16_t)(device->pointer & (device->page - 1));
+        device->start = device->pointer - device->column;
+        device->latched = 0;
+      }
+    }
+    else
+    {
+      /* Data bytes roll over within the page */
+      const uint16_t column = (uint16_t)((device->column + device->latched)
+          & (device->page - 1));
+
+      device->latch[column] = input[i];
+
+      if (device->latched < device->page)
+      {
+        ++device->latched;
+      }
+      else
+      {
+        /* Page is full, the oldest latched byte is overwritten */
+        device->column = (uint16_t)((device->column + 1)
+            & (device->page - 1));
+      }
+
+      device->pointer = device->start + ((column + 1) & (device->page - 1));
+    }
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the EEPROM model. Memory array is filled with the erased value.
+ * @param device Pointer to a device object.
+ * @param config Pointer to a configuration structure.
+ */
+void simM24Init(struct SimM24 *device, const struct SimM24Config *config)
+{
+  assert(config != NULL);
+  assert(config->memory != NULL);
+  assert(config->size && !(config->size & (config->size - 1)));
+  assert(config->page && config->page <= SIM_M24_PAGE_MAX);
+  assert(!(config->page & (config->page - 1)));
+
+  device->base.type = &deviceTable;
+  device->base.next = NULL;
+  device->base.address = config->address;
+
+  device->memory = config->memory;
+  device->size = config->size;
+  memset(device->memory, 0xFF, device->size);
+
+  device->pointer = 0;
+  device->start = 0;
+  device->cycle = (uint64_t)config->cycle * 1000;
+  device->ready = 0;
+
+  device->cycles = 0;
+  device->polls = 0;
+  device->read = 0;
+  device->written = 0;
+
+  device->received = 0;
+  /* Memories larger than 2 KiB use two address bytes */
+  device->width = device->size > 2048 ? 2 : 1;
+
+  device->column = 0;
+  device->latched = 0;
+  device->page = config->page;
+}
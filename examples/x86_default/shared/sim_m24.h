@@ -0,0 +1,69 @@
+/*
+ * x86_default/shared/sim_m24.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_M24_H_
+#define X86_DEFAULT_SHARED_SIM_M24_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_bus.h"
+/*----------------------------------------------------------------------------*/
+/* Maximum page size of the device model */
+#define SIM_M24_PAGE_MAX 256
+
+struct SimM24Config
+{
+  /** Mandatory: memory array, its size should be a power of two. */
+  uint8_t *memory;
+  /** Mandatory: memory size. */
+  uint32_t size;
+  /** Mandatory: device address on the bus. */
+  uint32_t address;
+  /** Mandatory: write cycle time in microseconds. */
+  uint32_t cycle;
+  /** Mandatory: page size, should be a power of two. */
+  uint16_t page;
+};
+
+struct SimM24
+{
+  struct SimDevice base;
+
+  /* Memory array */
+  uint8_t *memory;
+  uint32_t size;
+
+  /* Address counter */
+  uint32_t pointer;
+  /* Start of the page latched by the current write transaction */
+  uint32_t start;
+  /* Write cycle duration and end of the write cycle in nanoseconds */
+  uint64_t cycle;
+  uint64_t ready;
+
+  /* Statistics */
+  unsigned long cycles;
+  unsigned long polls;
+  unsigned long read;
+  unsigned long written;
+
+  /* Number of address bytes received in the current transaction */
+  uint8_t received;
+  /* Number of address bytes */
+  uint8_t width;
+
+  /* Page buffer and its state */
+  uint16_t column;
+  uint16_t latched;
+  uint16_t page;
+  uint8_t latch[SIM_M24_PAGE_MAX];
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simM24Init(struct SimM24 *, const struct SimM24Config *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_M24_H_ */
@@ -0,0 +1,161 @@
+/*
+ * x86_default/shared/sim_mpu60xx.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_mpu60xx.h"
+#include <assert.h>
+#include <string.h>
+/*----------------------------------------------------------------------------*/
+#define REG_ACCEL_CONFIG      0x1C
+#define REG_INT_STATUS        0x3A
+#define REG_ACCEL_XOUT_H      0x3B
+#define REG_GYRO_ZOUT_L       0x48
+#define REG_SIGNAL_PATH_RESET 0x68
+#define REG_USER_CTRL         0x6A
+#define REG_PWR_MGMT_1        0x6B
+#define REG_WHO_AM_I          0x75
+
+#define INT_STATUS_DATA_RDY   0x01
+#define PWR_MGMT_1_SLEEP      0x40
+#define PWR_MGMT_1_RESET      0x80
+#define USER_CTRL_RESET_MASK  0x07
+#define WHO_AM_I_VALUE        0x68
+
+/* Device lies flat and still at 25 degrees Celsius */
+#define ACCEL_Z_SCALE         16384
+#define TEMP_RAW              ((int16_t)((25.0 - 36.53) * 340.0))
+/*----------------------------------------------------------------------------*/
+static void deviceReset(struct SimMPU60XX *);
+static void deviceSample(struct SimMPU60XX *);
+static size_t deviceRead(struct SimDevice *, void *, size_t);
+static bool deviceSelect(struct SimDevice *);
+static size_t deviceWrite(struct SimDevice *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct SimDeviceClass deviceTable = {
+    .read = deviceRead,
+    .write = deviceWrite,
+    .select = deviceSelect,
+    .stop = NULL
+};
+/*----------------------------------------------------------------------------*/
+static void deviceReset(struct SimMPU60XX *device)
+{
+  memset(device->registers, 0, sizeof(device->registers));
+  device->registers[REG_PWR_MGMT_1] = PWR_MGMT_1_SLEEP;
+  device->registers[REG_WHO_AM_I] = WHO_AM_I_VALUE;
+}
+/*----------------------------------------------------------------------------*/
+static void deviceSample(struct SimMPU60XX *device)
+{
+  const unsigned int range = (device->registers[REG_ACCEL_CONFIG] >> 3) & 3;
+  const int16_t values[] = {
+      0, 0, (int16_t)(ACCEL_Z_SCALE >> range),
+      TEMP_RAW,
+      0, 0, 0
+  };
+  uint8_t *output = device->registers + REG_ACCEL_XOUT_H;
+
+  /* Output registers are big-endian */
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+  {
+    *output++ = (uint8_t)((uint16_t)values[i] >> 8);
+    *output++ = (uint8_t)values[i];
+  }
+
+  device->registers[REG_INT_STATUS] =
+      (device->registers[REG_PWR_MGMT_1] & PWR_MGMT_1_SLEEP) ?
+          0 : INT_STATUS_DATA_RDY;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *object, void *buffer, size_t length)
+{
+  struct SimMPU60XX * const device = (struct SimMPU60XX *)object;
+  uint8_t *output = buffer;
+
+  /* Burst read increments the register address */
+  for (size_t i = 0; i < length; ++i)
+  {
+    output[i] = device->registers[device->pointer];
+    device->pointer = (device->pointer + 1) & (SIM_MPU60XX_REGISTERS - 1);
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static bool deviceSelect(struct SimDevice *object)
+{
+  struct SimMPU60XX * const device = (struct SimMPU60XX *)object;
+
+  /* Every transaction observes a new sample */
+  deviceSample(device);
+
+  device->received = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceWrite(struct SimDevice *object, const void *buffer,
+    size_t length)
+{
+  struct SimMPU60XX * const device = (struct SimMPU60XX *)object;
+  const uint8_t *input = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (!device->received)
+    {
+      device->pointer = input[i] & (SIM_MPU60XX_REGISTERS - 1);
+      device->received = 1;
+      continue;
+    }
+
+    const uint8_t address = device->pointer;
+    uint8_t value = input[i];
+
+    device->pointer = (device->pointer + 1) & (SIM_MPU60XX_REGISTERS - 1);
+
+    /* Status, output and identification registers are read-only */
+    if (address == REG_INT_STATUS || address == REG_WHO_AM_I
+        || (address >= REG_ACCEL_XOUT_H && address <= REG_GYRO_ZOUT_L))
+    {
+      continue;
+    }
+
+    if (address == REG_PWR_MGMT_1 && (value & PWR_MGMT_1_RESET))
+    {
+      deviceReset(device);
+      continue;
+    }
+
+    /* Reset bits are cleared automatically */
+    if (address == REG_SIGNAL_PATH_RESET)
+      value = 0;
+    else if (address == REG_USER_CTRL)
+      value &= ~USER_CTRL_RESET_MASK;
+
+    device->registers[address] = value;
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the accelerometer and gyroscope model. Sensor lies flat
+ * and still, registers hold their power-on values.
+ * @param device Pointer to a device object.
+ * @param config Pointer to a configuration structure.
+ */
+void simMPU60XXInit(struct SimMPU60XX *device,
+    const struct SimMPU60XXConfig *config)
+{
+  assert(config != NULL);
+
+  device->base.type = &deviceTable;
+  device->base.next = NULL;
+  device->base.address = config->address;
+
+  device->pointer = 0;
+  device->received = 0;
+  deviceReset(device);
+}
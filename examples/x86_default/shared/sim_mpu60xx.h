@@ -0,0 +1,39 @@
+/*
+ * x86_default/shared/sim_mpu60xx.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_MPU60XX_H_
+#define X86_DEFAULT_SHARED_SIM_MPU60XX_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_bus.h"
+/*----------------------------------------------------------------------------*/
+/* Size of the register file of the device model */
+#define SIM_MPU60XX_REGISTERS 128
+
+struct SimMPU60XXConfig
+{
+  /** Mandatory: device address on the bus. */
+  uint32_t address;
+};
+
+struct SimMPU60XX
+{
+  struct SimDevice base;
+
+  /* Register file */
+  uint8_t registers[SIM_MPU60XX_REGISTERS];
+  /* Register address counter */
+  uint8_t pointer;
+  /* Number of bytes received in the current transaction */
+  uint8_t received;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simMPU60XXInit(struct SimMPU60XX *, const struct SimMPU60XXConfig *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_MPU60XX_H_ */
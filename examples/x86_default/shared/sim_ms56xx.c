@@ -0,0 +1,171 @@
+/*
+ * x86_default/shared/sim_ms56xx.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_ms56xx.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define CMD_ADC_READ    0x00
+#define CMD_RESET       0x1E
+#define CMD_CONVERT_D1  0x40
+#define CMD_CONVERT_D2  0x50
+#define CMD_PROM_READ   0xA0
+
+/* Digital pressure and temperature values, 20.00 C and 1100.02 mbar */
+#define D1_VALUE        6465444
+#define D2_VALUE        8077636
+/*----------------------------------------------------------------------------*/
+static uint8_t calcPromCrc(const uint16_t *);
+static size_t deviceRead(struct SimDevice *, void *, size_t);
+static bool deviceSelect(struct SimDevice *);
+static size_t deviceWrite(struct SimDevice *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct SimDeviceClass deviceTable = {
+    .read = deviceRead,
+    .write = deviceWrite,
+    .select = deviceSelect,
+    .stop = NULL
+};
+/* Calibration coefficients C1..C6 from the MS5607 datasheet example */
+static const uint16_t coefficients[] = {
+    46372, 43981, 29059, 27842, 31553, 28165
+};
+/* Maximum conversion time in microseconds for each oversampling ratio */
+static const uint16_t conversionTime[] = {
+    600, 1170, 2280, 4540, 9040
+};
+/*----------------------------------------------------------------------------*/
+static uint8_t calcPromCrc(const uint16_t *prom)
+{
+  uint16_t remainder = 0;
+
+  /* CRC-4 over the calibration memory, the CRC field itself is excluded */
+  for (size_t i = 0; i < 16; ++i)
+  {
+    uint16_t word = prom[i >> 1];
+
+    if (i == 15)
+      word &= 0xFF00;
+
+    remainder ^= (i & 1) ? (word & 0x00FF) : (word >> 8);
+
+    for (size_t bit = 0; bit < 8; ++bit)
+    {
+      if (remainder & 0x8000)
+        remainder = (uint16_t)((remainder << 1) ^ 0x3000);
+      else
+        remainder = (uint16_t)(remainder << 1);
+    }
+  }
+
+  return (uint8_t)((remainder >> 12) & 0x0F);
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *object, void *buffer, size_t length)
+{
+  struct SimMS56XX * const device = (struct SimMS56XX *)object;
+  uint8_t *output = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    uint8_t value = 0;
+
+    if (device->command == CMD_ADC_READ)
+    {
+      if (device->sent < 3)
+        value = (uint8_t)(device->result >> (8 * (2 - device->sent)));
+    }
+    else if ((device->command & 0xF0) == CMD_PROM_READ)
+    {
+      const uint16_t word = device->prom[(device->command >> 1) & 0x07];
+
+      if (device->sent < 2)
+        value = (uint8_t)(word >> (8 * (1 - device->sent)));
+    }
+
+    output[i] = value;
+    ++device->sent;
+  }
+
+  /* Conversion result is cleared after it has been read */
+  if (device->command == CMD_ADC_READ && device->sent >= 3)
+    device->result = 0;
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static bool deviceSelect(struct SimDevice *object)
+{
+  struct SimMS56XX * const device = (struct SimMS56XX *)object;
+
+  device->sent = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceWrite(struct SimDevice *object, const void *buffer,
+    size_t length)
+{
+  struct SimMS56XX * const device = (struct SimMS56XX *)object;
+  const uint8_t *input = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    const uint8_t command = input[i];
+
+    device->command = command;
+
+    if (command == CMD_ADC_READ)
+    {
+      /* Reading before the end of the conversion returns zero */
+      if (simTime() < device->ready)
+        device->result = 0;
+    }
+    else if (command == CMD_RESET)
+    {
+      device->ready = 0;
+      device->result = 0;
+    }
+    else if ((command & 0xE0) == CMD_CONVERT_D1)
+    {
+      const unsigned int osr = (command & 0x0F) >> 1;
+
+      if (osr < sizeof(conversionTime) / sizeof(conversionTime[0]))
+      {
+        device->ready = simTime() + (uint64_t)conversionTime[osr] * 1000;
+        device->result = (command & 0xF0) == CMD_CONVERT_D1 ?
+            D1_VALUE : D2_VALUE;
+      }
+    }
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the pressure sensor model. Calibration memory holds
+ * the coefficients from the datasheet example and a valid CRC.
+ * @param device Pointer to a device object.
+ * @param config Pointer to a configuration structure.
+ */
+void simMS56XXInit(struct SimMS56XX *device,
+    const struct SimMS56XXConfig *config)
+{
+  assert(config != NULL);
+
+  device->base.type = &deviceTable;
+  device->base.next = NULL;
+  device->base.address = config->address;
+
+  device->prom[0] = 0;
+  for (size_t i = 0; i < 6; ++i)
+    device->prom[i + 1] = coefficients[i];
+  device->prom[7] = 0;
+  device->prom[7] |= calcPromCrc(device->prom);
+
+  device->ready = 0;
+  device->result = 0;
+  device->command = CMD_RESET;
+  device->sent = 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * x86_default/shared/sim_ms56xx.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_MS56XX_H_
+#define X86_DEFAULT_SHARED_SIM_MS56XX_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_bus.h"
+/*----------------------------------------------------------------------------*/
+struct SimMS56XXConfig
+{
+  /** Mandatory: device address on the bus. */
+  uint32_t address;
+};
+
+struct SimMS56XX
+{
+  struct SimDevice base;
+
+  /* Calibration memory */
+  uint16_t prom[8];
+  /* End of the conversion in progress in nanoseconds */
+  uint64_t ready;
+  /* Result of the last conversion */
+  uint32_t result;
+
+  /* Last command */
+  uint8_t command;
+  /* Number of bytes read in the current transaction */
+  uint8_t sent;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simMS56XXInit(struct SimMS56XX *, const struct SimMS56XXConfig *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_MS56XX_H_ */
@@ -0,0 +1,236 @@
+/*
+ * x86_default/shared/sim_serial.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_serial.h"
+#include <assert.h>
+#include <unistd.h>
+/*----------------------------------------------------------------------------*/
+/* Maximum number of bytes moved to the output descriptor per drain event */
+#define TX_CHUNK_SIZE 64
+/*----------------------------------------------------------------------------*/
+static uint64_t calcTransmitTime(const struct SimSerial *, size_t);
+static void onTxEvent(void *);
+static void *rxThread(void *);
+
+static enum Result serialInit(void *, const void *);
+static void serialDeinit(void *);
+static void serialSetCallback(void *, void (*)(void *), void *);
+static enum Result serialGetParam(void *, int, void *);
+static enum Result serialSetParam(void *, int, const void *);
+static size_t serialRead(void *, void *, size_t);
+static size_t serialWrite(void *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+const struct InterfaceClass * const SimSerial = &(const struct InterfaceClass){
+    .size = sizeof(struct SimSerial),
+    .init = serialInit,
+    .deinit = serialDeinit,
+
+    .setCallback = serialSetCallback,
+    .getParam = serialGetParam,
+    .setParam = serialSetParam,
+    .read = serialRead,
+    .write = serialWrite
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t calcTransmitTime(const struct SimSerial *interface,
+    size_t count)
+{
+  /* Start bit, 8 data bits and stop bit */
+  return (uint64_t)count * 10 * 1000000000 / interface->rate;
+}
+/*----------------------------------------------------------------------------*/
+static void onTxEvent(void *object)
+{
+  struct SimSerial * const interface = object;
+  uint8_t buffer[TX_CHUNK_SIZE];
+  const size_t count = byteQueuePopArray(&interface->txQueue, buffer,
+      sizeof(buffer));
+
+  if (count && interface->tx >= 0)
+  {
+    const ssize_t written = write(interface->tx, buffer, count);
+    (void)written;
+  }
+
+  if (!byteQueueEmpty(&interface->txQueue))
+  {
+    const size_t pending = MIN(byteQueueSize(&interface->txQueue),
+        TX_CHUNK_SIZE);
+
+    simEventSchedule(&interface->txEvent,
+        calcTransmitTime(interface, pending));
+  }
+  else if (interface->callback != NULL)
+    interface->callback(interface->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void *rxThread(void *object)
+{
+  struct SimSerial * const interface = object;
+  uint8_t buffer[TX_CHUNK_SIZE];
+  ssize_t count;
+
+  while ((count = read(interface->rx, buffer, sizeof(buffer))) > 0)
+  {
+    simIrqLock();
+
+    byteQueuePushArray(&interface->rxQueue, buffer, (size_t)count);
+    if (interface->callback != NULL)
+      interface->callback(interface->callbackArgument);
+
+    simIrqUnlock();
+  }
+
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result serialInit(void *object, const void *configBase)
+{
+  const struct SimSerialConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->rate > 0);
+
+  struct SimSerial * const interface = object;
+
+  if (!byteQueueInit(&interface->rxQueue, config->rxLength))
+    return E_MEMORY;
+  if (!byteQueueInit(&interface->txQueue, config->txLength))
+    return E_MEMORY;
+
+  simEventInit(&interface->txEvent, onTxEvent, interface);
+
+  interface->callback = NULL;
+  interface->rate = config->rate;
+  interface->rx = config->rx;
+  interface->tx = config->tx;
+
+  if (interface->rx >= 0)
+  {
+    if (pthread_create(&interface->thread, NULL, rxThread, interface) != 0)
+      return E_ERROR;
+    pthread_detach(interface->thread);
+  }
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void serialDeinit(void *object)
+{
+  struct SimSerial * const interface = object;
+
+  simEventCancel(&interface->txEvent);
+
+  if (interface->rx >= 0)
+    pthread_cancel(interface->thread);
+
+  byteQueueDeinit(&interface->txQueue);
+  byteQueueDeinit(&interface->rxQueue);
+}
+/*----------------------------------------------------------------------------*/
+static void serialSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimSerial * const interface = object;
+
+  interface->callbackArgument = argument;
+  interface->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result serialGetParam(void *object, int parameter, void *data)
+{
+  struct SimSerial * const interface = object;
+  enum Result res = E_OK;
+
+  simIrqLock();
+
+  switch (parameter)
+  {
+    case IF_RATE:
+      *(uint32_t *)data = interface->rate;
+      break;
+
+    case IF_RX_AVAILABLE:
+      *(size_t *)data = byteQueueSize(&interface->rxQueue);
+      break;
+
+    case IF_RX_PENDING:
+      *(size_t *)data = byteQueueCapacity(&interface->rxQueue)
+          - byteQueueSize(&interface->rxQueue);
+      break;
+
+    case IF_TX_AVAILABLE:
+      *(size_t *)data = byteQueueCapacity(&interface->txQueue)
+          - byteQueueSize(&interface->txQueue);
+      break;
+
+    case IF_TX_PENDING:
+      *(size_t *)data = byteQueueSize(&interface->txQueue);
+      break;
+
+    default:
+      res = E_INVALID;
+      break;
+  }
+
+  simIrqUnlock();
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result serialSetParam(void *object, int parameter,
+    const void *data)
+{
+  struct SimSerial * const interface = object;
+
+  switch (parameter)
+  {
+    case IF_RATE:
+    {
+      const uint32_t rate = *(const uint32_t *)data;
+
+      if (!rate)
+        return E_VALUE;
+
+      interface->rate = rate;
+      return E_OK;
+    }
+
+    default:
+      return E_INVALID;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static size_t serialRead(void *object, void *buffer, size_t length)
+{
+  struct SimSerial * const interface = object;
+  size_t count;
+
+  simIrqLock();
+  count = byteQueuePopArray(&interface->rxQueue, buffer, length);
+  simIrqUnlock();
+
+  return count;
+}
+/*----------------------------------------------------------------------------*/
+static size_t serialWrite(void *object, const void *buffer, size_t length)
+{
+  struct SimSerial * const interface = object;
+  size_t count;
+
+  simIrqLock();
+
+  const bool idle = byteQueueEmpty(&interface->txQueue);
+
+  count = byteQueuePushArray(&interface->txQueue, buffer, length);
+
+  if (idle && count)
+  {
+    simEventSchedule(&interface->txEvent,
+        calcTransmitTime(interface, MIN(count, TX_CHUNK_SIZE)));
+  }
+
+  simIrqUnlock();
+  return count;
+}
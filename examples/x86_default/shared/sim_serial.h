@@ -0,0 +1,54 @@
+/*
+ * x86_default/shared/sim_serial.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_SERIAL_H_
+#define X86_DEFAULT_SHARED_SIM_SERIAL_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_core.h"
+#include <xcore/containers/byte_queue.h>
+#include <xcore/interface.h>
+#include <pthread.h>
+/*----------------------------------------------------------------------------*/
+extern const struct InterfaceClass * const SimSerial;
+
+struct SimSerialConfig
+{
+  /** Mandatory: input queue size. */
+  size_t rxLength;
+  /** Mandatory: output queue size. */
+  size_t txLength;
+  /** Mandatory: baud rate used for the output timing model. */
+  uint32_t rate;
+  /** Mandatory: input file descriptor, negative value disables the input. */
+  int rx;
+  /** Mandatory: output file descriptor, negative value discards the output. */
+  int tx;
+};
+
+struct SimSerial
+{
+  struct Interface base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Input queue */
+  struct ByteQueue rxQueue;
+  /* Output queue */
+  struct ByteQueue txQueue;
+  /* Output drain event */
+  struct SimEvent txEvent;
+  /* Input reader */
+  pthread_t thread;
+
+  /* Current baud rate */
+  uint32_t rate;
+  /* File descriptors */
+  int rx;
+  int tx;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_SERIAL_H_ */
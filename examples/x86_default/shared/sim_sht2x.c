@@ -0,0 +1,179 @@
+/*
+ * x86_default/shared/sim_sht2x.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_sht2x.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+#define CMD_T_HOLD      0xE3
+#define CMD_RH_HOLD     0xE5
+#define CMD_WRITE_USER  0xE6
+#define CMD_READ_USER   0xE7
+#define CMD_T_NO_HOLD   0xF3
+#define CMD_RH_NO_HOLD  0xF5
+#define CMD_RESET       0xFE
+
+/* Reserved bits of the user register are kept on writes */
+#define USER_DEFAULT    0x3A
+#define USER_RESERVED   0x78
+/* Soft reset time in microseconds */
+#define RESET_TIME      15000
+
+/* Raw values for 25.0 C and 50.0 %RH, status bit marks humidity */
+#define T_RAW           26796
+#define RH_RAW          (29362 | 0x0002)
+/*----------------------------------------------------------------------------*/
+static uint8_t calcCrc8(const uint8_t *, size_t);
+static void startMeasurement(struct SimSHT2X *, bool, bool);
+static size_t deviceRead(struct SimDevice *, void *, size_t);
+static bool deviceSelect(struct SimDevice *);
+static size_t deviceWrite(struct SimDevice *, const void *, size_t);
+/*----------------------------------------------------------------------------*/
+static const struct SimDeviceClass deviceTable = {
+    .read = deviceRead,
+    .write = deviceWrite,
+    .select = deviceSelect,
+    .stop = NULL
+};
+/* Maximum measurement times in microseconds for each resolution setting */
+static const uint32_t humidityTime[] = {29000, 4000, 9000, 15000};
+static const uint32_t temperatureTime[] = {85000, 22000, 43000, 11000};
+/*----------------------------------------------------------------------------*/
+static uint8_t calcCrc8(const uint8_t *buffer, size_t length)
+{
+  uint8_t crc = 0;
+
+  /* Polynomial x^8 + x^5 + x^4 + 1 */
+  for (size_t i = 0; i < length; ++i)
+  {
+    crc ^= buffer[i];
+
+    for (size_t bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+  }
+
+  return crc;
+}
+/*----------------------------------------------------------------------------*/
+static void startMeasurement(struct SimSHT2X *device, bool humidity,
+    bool hold)
+{
+  const unsigned int resolution =
+      ((device->user >> 6) & 0x02) | (device->user & 0x01);
+  const uint16_t value = humidity ? RH_RAW : T_RAW;
+  const uint32_t duration = humidity ?
+      humidityTime[resolution] : temperatureTime[resolution];
+
+  device->response[0] = (uint8_t)(value >> 8);
+  device->response[1] = (uint8_t)value;
+  device->response[2] = calcCrc8(device->response, 2);
+  device->length = 3;
+
+  /* Clock stretching is not modeled, result is ready in hold mode */
+  device->ready = hold ? 0 : simTime() + (uint64_t)duration * 1000;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceRead(struct SimDevice *object, void *buffer, size_t length)
+{
+  struct SimSHT2X * const device = (struct SimSHT2X *)object;
+  uint8_t *output = buffer;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    output[i] = device->sent < device->length ?
+        device->response[device->sent] : 0xFF;
+    ++device->sent;
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+static bool deviceSelect(struct SimDevice *object)
+{
+  struct SimSHT2X * const device = (struct SimSHT2X *)object;
+
+  /* Device address is not acknowledged during measurement or reset */
+  if (simTime() < device->ready)
+    return false;
+
+  device->received = 0;
+  device->sent = 0;
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+static size_t deviceWrite(struct SimDevice *object, const void *buffer,
+    size_t length)
+{
+  struct SimSHT2X * const device = (struct SimSHT2X *)object;
+  const uint8_t *input = buffer;
+
+  for (size_t i = 0; i < length; ++i, ++device->received)
+  {
+    if (device->received)
+    {
+      /* Argument of the user register write */
+      if (device->command == CMD_WRITE_USER && device->received == 1)
+      {
+        device->user = (uint8_t)((device->user & USER_RESERVED)
+            | (input[i] & ~USER_RESERVED));
+      }
+      continue;
+    }
+
+    device->command = input[i];
+    device->length = 0;
+
+    switch (device->command)
+    {
+      case CMD_T_HOLD:
+      case CMD_T_NO_HOLD:
+        startMeasurement(device, false, device->command == CMD_T_HOLD);
+        break;
+
+      case CMD_RH_HOLD:
+      case CMD_RH_NO_HOLD:
+        startMeasurement(device, true, device->command == CMD_RH_HOLD);
+        break;
+
+      case CMD_READ_USER:
+        device->response[0] = device->user;
+        device->length = 1;
+        break;
+
+      case CMD_RESET:
+        device->user = USER_DEFAULT;
+        device->ready = simTime() + (uint64_t)RESET_TIME * 1000;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  return length;
+}
+/*----------------------------------------------------------------------------*/
+/**
+ * Initialize the humidity and temperature sensor model. Sensor measures
+ * constant values, user register holds its power-on value.
+ * @param device Pointer to a device object.
+ * @param config Pointer to a configuration structure.
+ */
+void simSHT2XInit(struct SimSHT2X *device,
+    const struct SimSHT2XConfig *config)
+{
+  assert(config != NULL);
+
+  device->base.type = &deviceTable;
+  device->base.next = NULL;
+  device->base.address = config->address;
+
+  device->ready = 0;
+  device->length = 0;
+  device->sent = 0;
+  device->received = 0;
+  device->command = 0;
+  device->user = USER_DEFAULT;
+}
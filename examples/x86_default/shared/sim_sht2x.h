@@ -0,0 +1,44 @@
+/*
+ * x86_default/shared/sim_sht2x.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_SHT2X_H_
+#define X86_DEFAULT_SHARED_SIM_SHT2X_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_bus.h"
+/*----------------------------------------------------------------------------*/
+struct SimSHT2XConfig
+{
+  /** Mandatory: device address on the bus. */
+  uint32_t address;
+};
+
+struct SimSHT2X
+{
+  struct SimDevice base;
+
+  /* End of the measurement or reset in progress in nanoseconds */
+  uint64_t ready;
+  /* Response of the last command with the checksum */
+  uint8_t response[3];
+  /* Length of the response */
+  uint8_t length;
+  /* Number of bytes read in the current transaction */
+  uint8_t sent;
+  /* Number of bytes received in the current transaction */
+  uint8_t received;
+  /* Last command */
+  uint8_t command;
+  /* User register */
+  uint8_t user;
+};
+/*----------------------------------------------------------------------------*/
+BEGIN_DECLS
+
+void simSHT2XInit(struct SimSHT2X *, const struct SimSHT2XConfig *);
+
+END_DECLS
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_SHT2X_H_ */
@@ -0,0 +1,194 @@
+/*
+ * x86_default/shared/sim_timer.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_timer.h"
+#include <assert.h>
+/*----------------------------------------------------------------------------*/
+static uint64_t ticksToTime(const struct SimTimer *, uint32_t);
+static void onTimerEvent(void *);
+static void scheduleOverflow(struct SimTimer *);
+
+static enum Result tmrInit(void *, const void *);
+static void tmrDeinit(void *);
+static void tmrEnable(void *);
+static void tmrDisable(void *);
+static void tmrSetAutostop(void *, bool);
+static void tmrSetCallback(void *, void (*)(void *), void *);
+static uint32_t tmrGetFrequency(const void *);
+static void tmrSetFrequency(void *, uint32_t);
+static uint32_t tmrGetOverflow(const void *);
+static void tmrSetOverflow(void *, uint32_t);
+static uint32_t tmrGetValue(const void *);
+static void tmrSetValue(void *, uint32_t);
+/*----------------------------------------------------------------------------*/
+const struct TimerClass * const SimTimer = &(const struct TimerClass){
+    .size = sizeof(struct SimTimer),
+    .init = tmrInit,
+    .deinit = tmrDeinit,
+
+    .enable = tmrEnable,
+    .disable = tmrDisable,
+    .setAutostop = tmrSetAutostop,
+    .setCallback = tmrSetCallback,
+    .getFrequency = tmrGetFrequency,
+    .setFrequency = tmrSetFrequency,
+    .getOverflow = tmrGetOverflow,
+    .setOverflow = tmrSetOverflow,
+    .getValue = tmrGetValue,
+    .setValue = tmrSetValue
+};
+/*----------------------------------------------------------------------------*/
+static uint64_t ticksToTime(const struct SimTimer *timer, uint32_t ticks)
+{
+  return (uint64_t)ticks * 1000000000 / timer->frequency;
+}
+/*----------------------------------------------------------------------------*/
+static void onTimerEvent(void *object)
+{
+  struct SimTimer * const timer = object;
+
+  timer->origin += ticksToTime(timer, timer->overflow);
+
+  if (timer->autostop)
+    timer->enabled = false;
+  else
+    scheduleOverflow(timer);
+
+  if (timer->callback != NULL)
+    timer->callback(timer->callbackArgument);
+}
+/*----------------------------------------------------------------------------*/
+static void scheduleOverflow(struct SimTimer *timer)
+{
+  if (!timer->overflow)
+    return;
+
+  const uint64_t deadline =
+      timer->origin + ticksToTime(timer, timer->overflow);
+  const uint64_t current = simTime();
+
+  simEventSchedule(&timer->event,
+      deadline > current ? deadline - current : 0);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result tmrInit(void *object, const void *configBase)
+{
+  const struct SimTimerConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->frequency > 0);
+
+  struct SimTimer * const timer = object;
+
+  simEventInit(&timer->event, onTimerEvent, timer);
+
+  timer->callback = NULL;
+  timer->origin = simTime();
+  timer->frequency = config->frequency;
+  timer->overflow = 0;
+  timer->autostop = false;
+  timer->enabled = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDeinit(void *object)
+{
+  struct SimTimer * const timer = object;
+  simEventCancel(&timer->event);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrEnable(void *object)
+{
+  struct SimTimer * const timer = object;
+
+  if (!timer->enabled)
+  {
+    timer->enabled = true;
+    timer->origin = simTime();
+    scheduleOverflow(timer);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static void tmrDisable(void *object)
+{
+  struct SimTimer * const timer = object;
+
+  timer->enabled = false;
+  simEventCancel(&timer->event);
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetAutostop(void *object, bool state)
+{
+  struct SimTimer * const timer = object;
+  timer->autostop = state;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetCallback(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimTimer * const timer = object;
+
+  timer->callbackArgument = argument;
+  timer->callback = callback;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetFrequency(const void *object)
+{
+  const struct SimTimer * const timer = object;
+  return timer->frequency;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetFrequency(void *object, uint32_t frequency)
+{
+  struct SimTimer * const timer = object;
+
+  if (frequency)
+    timer->frequency = frequency;
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetOverflow(const void *object)
+{
+  const struct SimTimer * const timer = object;
+  return timer->overflow;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetOverflow(void *object, uint32_t overflow)
+{
+  struct SimTimer * const timer = object;
+
+  timer->overflow = overflow;
+
+  if (timer->enabled)
+  {
+    if (timer->overflow)
+      scheduleOverflow(timer);
+    else
+      simEventCancel(&timer->event);
+  }
+}
+/*----------------------------------------------------------------------------*/
+static uint32_t tmrGetValue(const void *object)
+{
+  const struct SimTimer * const timer = object;
+  const uint64_t elapsed = simTime() - timer->origin;
+  const uint64_t ticks = (elapsed / 1000000000) * timer->frequency
+      + (elapsed % 1000000000) * timer->frequency / 1000000000;
+
+  if (timer->overflow)
+    return (uint32_t)(ticks % timer->overflow);
+  else
+    return (uint32_t)ticks;
+}
+/*----------------------------------------------------------------------------*/
+static void tmrSetValue(void *object, uint32_t value)
+{
+  struct SimTimer * const timer = object;
+
+  timer->origin = simTime() - ticksToTime(timer, value);
+
+  if (timer->enabled)
+    scheduleOverflow(timer);
+}
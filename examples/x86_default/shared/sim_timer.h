@@ -0,0 +1,39 @@
+/*
+ * x86_default/shared/sim_timer.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_TIMER_H_
+#define X86_DEFAULT_SHARED_SIM_TIMER_H_
+/*----------------------------------------------------------------------------*/
+#include "sim_core.h"
+#include <halm/timer.h>
+/*----------------------------------------------------------------------------*/
+extern const struct TimerClass * const SimTimer;
+
+struct SimTimerConfig
+{
+  /** Mandatory: timer frequency. */
+  uint32_t frequency;
+};
+
+struct SimTimer
+{
+  struct Timer base;
+
+  void (*callback)(void *);
+  void *callbackArgument;
+
+  /* Overflow event descriptor */
+  struct SimEvent event;
+  /* Time of the last counter reset in nanoseconds */
+  uint64_t origin;
+
+  uint32_t frequency;
+  uint32_t overflow;
+  bool autostop;
+  bool enabled;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_TIMER_H_ */
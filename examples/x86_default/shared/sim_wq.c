@@ -0,0 +1,166 @@
+/*
+ * x86_default/shared/sim_wq.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "sim_core.h"
+#include "sim_wq.h"
+#include <assert.h>
+#include <stdlib.h>
+/*----------------------------------------------------------------------------*/
+static void *wqThread(void *);
+
+static enum Result wqInit(void *, const void *);
+static void wqDeinit(void *);
+static enum Result wqEnqueue(void *, void (*)(void *), void *);
+static void wqExecute(void *);
+static void wqTerminate(void *);
+/*----------------------------------------------------------------------------*/
+const struct WorkQueueClass * const SimWorkQueue =
+    &(const struct WorkQueueClass){
+    .size = sizeof(struct SimWorkQueue),
+    .init = wqInit,
+    .deinit = wqDeinit,
+
+    .add = wqEnqueue,
+    .start = wqExecute,
+    .stop = wqTerminate
+};
+/*----------------------------------------------------------------------------*/
+static void *wqThread(void *object)
+{
+  struct SimWorkQueue * const wq = object;
+
+  pthread_mutex_lock(&wq->lock);
+
+  while (wq->running)
+  {
+    if (!wq->count)
+    {
+      pthread_cond_wait(&wq->update, &wq->lock);
+      continue;
+    }
+
+    const struct SimWorkQueueTask task = wq->tasks[wq->head];
+
+    wq->head = (wq->head + 1) % wq->capacity;
+    --wq->count;
+    pthread_mutex_unlock(&wq->lock);
+
+    /* Tasks are serialized with simulated interrupts and other queues */
+    simIrqLock();
+    task.callback(task.argument);
+    simIrqUnlock();
+
+    pthread_mutex_lock(&wq->lock);
+  }
+
+  pthread_mutex_unlock(&wq->lock);
+  return NULL;
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wqInit(void *object, const void *configBase)
+{
+  const struct SimWorkQueueConfig * const config = configBase;
+  assert(config != NULL);
+  assert(config->size > 0);
+
+  struct SimWorkQueue * const wq = object;
+
+  wq->tasks = malloc(sizeof(struct SimWorkQueueTask) * config->size);
+  if (wq->tasks == NULL)
+    return E_MEMORY;
+
+  pthread_mutex_init(&wq->lock, NULL);
+  pthread_cond_init(&wq->update, NULL);
+
+  wq->capacity = config->size;
+  wq->count = 0;
+  wq->head = 0;
+  wq->foreground = config->foreground;
+  wq->running = false;
+
+  return E_OK;
+}
+/*----------------------------------------------------------------------------*/
+static void wqDeinit(void *object)
+{
+  struct SimWorkQueue * const wq = object;
+
+  wqTerminate(wq);
+
+  pthread_cond_destroy(&wq->update);
+  pthread_mutex_destroy(&wq->lock);
+  free(wq->tasks);
+}
+/*----------------------------------------------------------------------------*/
+static enum Result wqEnqueue(void *object, void (*callback)(void *),
+    void *argument)
+{
+  struct SimWorkQueue * const wq = object;
+  enum Result res = E_OK;
+
+  pthread_mutex_lock(&wq->lock);
+
+  if (wq->count < wq->capacity)
+  {
+    const size_t tail = (wq->head + wq->count) % wq->capacity;
+
+    wq->tasks[tail] = (struct SimWorkQueueTask){callback, argument};
+    ++wq->count;
+    pthread_cond_signal(&wq->update);
+  }
+  else
+    res = E_FULL;
+
+  pthread_mutex_unlock(&wq->lock);
+  return res;
+}
+/*----------------------------------------------------------------------------*/
+static void wqExecute(void *object)
+{
+  struct SimWorkQueue * const wq = object;
+
+  pthread_mutex_lock(&wq->lock);
+
+  if (wq->running)
+  {
+    pthread_mutex_unlock(&wq->lock);
+    return;
+  }
+
+  wq->running = true;
+
+  if (wq->foreground)
+  {
+    /* Function returns when the queue is stopped, like the default queue */
+    wq->thread = pthread_self();
+    pthread_mutex_unlock(&wq->lock);
+
+    wqThread(wq);
+    return;
+  }
+
+  /* Background queue starts its own thread and returns immediately */
+  if (pthread_create(&wq->thread, NULL, wqThread, wq) != 0)
+    wq->running = false;
+
+  pthread_mutex_unlock(&wq->lock);
+}
+/*----------------------------------------------------------------------------*/
+static void wqTerminate(void *object)
+{
+  struct SimWorkQueue * const wq = object;
+  bool running;
+
+  pthread_mutex_lock(&wq->lock);
+  running = wq->running;
+  wq->running = false;
+  pthread_cond_signal(&wq->update);
+  pthread_mutex_unlock(&wq->lock);
+
+  if (running && !wq->foreground
+      && !pthread_equal(pthread_self(), wq->thread))
+    pthread_join(wq->thread, NULL);
+}
@@ -0,0 +1,50 @@
+/*
+ * x86_default/shared/sim_wq.h
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#ifndef X86_DEFAULT_SHARED_SIM_WQ_H_
+#define X86_DEFAULT_SHARED_SIM_WQ_H_
+/*----------------------------------------------------------------------------*/
+#include <halm/wq.h>
+#include <pthread.h>
+/*----------------------------------------------------------------------------*/
+extern const struct WorkQueueClass * const SimWorkQueue;
+
+struct SimWorkQueueConfig
+{
+  /** Mandatory: maximum number of pending tasks. */
+  size_t size;
+  /**
+   * Optional: run tasks on the calling thread, the start function returns
+   * only when the queue is stopped.
+   */
+  bool foreground;
+};
+
+struct SimWorkQueueTask
+{
+  void (*callback)(void *);
+  void *argument;
+};
+
+struct SimWorkQueue
+{
+  struct WorkQueue base;
+
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t update;
+
+  /* Circular buffer with pending tasks */
+  struct SimWorkQueueTask *tasks;
+  size_t capacity;
+  size_t count;
+  size_t head;
+
+  bool foreground;
+  bool running;
+};
+/*----------------------------------------------------------------------------*/
+#endif /* X86_DEFAULT_SHARED_SIM_WQ_H_ */
@@ -0,0 +1,134 @@
+/*
+ * x86_default/ws281x_transpose/main.c
+ * Copyright (C) 2026 xent
+ * Project is distributed under the terms of the GNU General Public License v3.0
+ */
+
+#include "led_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+/*----------------------------------------------------------------------------*/
+#define INPUT_STRIDE  5
+#define OUTPUT_STRIDE 3
+#define MATRIX_COUNT  4096
+#define ROUND_COUNT   256
+/*----------------------------------------------------------------------------*/
+typedef void (*Transposer)(uint8_t *, size_t, const uint8_t *, size_t);
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void);
+static void runBenchmark(Transposer, const uint8_t *, double *);
+static void transposeReference(uint8_t *, size_t, const uint8_t *, size_t);
+static bool verify(const uint8_t *, size_t);
+/*----------------------------------------------------------------------------*/
+static uint64_t getTime(void)
+{
+  struct timespec current;
+
+  clock_gettime(CLOCK_MONOTONIC, &current);
+  return (uint64_t)current.tv_sec * 1000000000 + (uint64_t)current.tv_nsec;
+}
+/*----------------------------------------------------------------------------*/
+static void runBenchmark(Transposer transposer, const uint8_t *matrices,
+    double *nanoseconds)
+{
+  const uint64_t startTime = getTime();
+  volatile uint8_t sink = 0;
+  uint8_t output[8 * OUTPUT_STRIDE];
+
+  for (size_t round = 0; round < ROUND_COUNT; ++round)
+  {
+    for (size_t i = 0; i < MATRIX_COUNT; ++i)
+    {
+      transposer(output, OUTPUT_STRIDE, matrices + i * 8 * INPUT_STRIDE,
+          INPUT_STRIDE);
+      sink ^= output[0];
+    }
+  }
+
+  *nanoseconds = (double)(getTime() - startTime)
+      / ((double)ROUND_COUNT * MATRIX_COUNT);
+}
+/*----------------------------------------------------------------------------*/
+/* Bit by bit implementation of the transposition, used as a reference */
+static void transposeReference(uint8_t *output, size_t outputStride,
+    const uint8_t *input, size_t inputStride)
+{
+  for (size_t k = 0; k < 8; ++k)
+  {
+    uint8_t value = 0;
+
+    for (size_t n = 0; n < 8; ++n)
+    {
+      if (input[n * inputStride] & (0x80 >> k))
+        value |= (uint8_t)(1 << n);
+    }
+
+    output[k * outputStride] = value;
+  }
+}
+/*----------------------------------------------------------------------------*/
+static bool verify(const uint8_t *input, size_t index)
+{
+  uint8_t expected[8 * OUTPUT_STRIDE] = {0};
+  uint8_t result[8 * OUTPUT_STRIDE] = {0};
+
+  transposeReference(expected, OUTPUT_STRIDE, input, INPUT_STRIDE);
+  ws281xTranspose(result, OUTPUT_STRIDE, input, INPUT_STRIDE);
+
+  for (size_t k = 0; k < 8; ++k)
+  {
+    if (expected[k * OUTPUT_STRIDE] != result[k * OUTPUT_STRIDE])
+    {
+      printf("matrix %zu, byte %zu: expected 0x%02X, got 0x%02X\n",
+          index, k, expected[k * OUTPUT_STRIDE], result[k * OUTPUT_STRIDE]);
+      return false;
+    }
+  }
+
+  return true;
+}
+/*----------------------------------------------------------------------------*/
+int main(void)
+{
+  static uint8_t matrices[MATRIX_COUNT * 8 * INPUT_STRIDE];
+  bool passed = true;
+
+  srand(0);
+
+  /* Every value of every lane with other lanes cleared */
+  for (size_t lane = 0; lane < 8 && passed; ++lane)
+  {
+    for (unsigned int value = 0; value < 256 && passed; ++value)
+    {
+      uint8_t input[8 * INPUT_STRIDE] = {0};
+
+      input[lane * INPUT_STRIDE] = (uint8_t)value;
+      passed = verify(input, lane * 256 + value);
+    }
+  }
+
+  /* Random matrices, bytes between the lanes are random too */
+  for (size_t i = 0; i < sizeof(matrices); ++i)
+    matrices[i] = (uint8_t)rand();
+
+  for (size_t i = 0; i < MATRIX_COUNT && passed; ++i)
+    passed = verify(matrices + i * 8 * INPUT_STRIDE, i);
+
+  if (!passed)
+  {
+    printf("transpose: output mismatch\n");
+    return EXIT_FAILURE;
+  }
+
+  double referenceTime, transposeTime;
+
+  runBenchmark(transposeReference, matrices, &referenceTime);
+  runBenchmark(ws281xTranspose, matrices, &transposeTime);
+
+  printf("reference,ns transpose,ns speedup\n");
+  printf("%.1f %.1f %.2f\n", referenceTime, transposeTime,
+      referenceTime / transposeTime);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# decode_telemetry.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+'''Decode binary telemetry frames produced by sensor examples.
+
+This module converts a binary telemetry stream back to the text format
+of sensor examples.
+'''
+
+import argparse
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+FRAME_DATA = 0
+FRAME_FORMAT = 1
+HEADER_SIZE = 5
+CRC_SIZE = 2
+
+SENSOR_TYPE_ACCEL = 0
+SENSOR_TYPE_BARO = 1
+SENSOR_TYPE_GYRO = 2
+SENSOR_TYPE_HYGRO = 3
+SENSOR_TYPE_MAG = 4
+SENSOR_TYPE_THERMO = 5
+SENSOR_TYPE_CUSTOM = 6
+SENSOR_TYPE_ATTITUDE = 7
+
+# Prefix, suffix, sign of the integer part and precision for each sensor type
+TEXT_FORMATS = {
+    SENSOR_TYPE_ACCEL: ('{timestamp} a: ', ' g', True, 3),
+    SENSOR_TYPE_BARO: ('P:  ', ' Pa', False, 3),
+    SENSOR_TYPE_GYRO: ('{timestamp} w: ', ' rad/s', True, 3),
+    SENSOR_TYPE_HYGRO: ('H:  ', ' %', False, 3),
+    SENSOR_TYPE_MAG: ('{timestamp} H: ', ' Ga', True, 3),
+    SENSOR_TYPE_THERMO: ('{timestamp} T: ', ' C', True, 3),
+    SENSOR_TYPE_CUSTOM: ('', '', False, 0),
+    SENSOR_TYPE_ATTITUDE: ('{timestamp} q: ', '', True, 4)
+}
+
+def calc_crc16(data):
+    crc = 0xFFFF
+    for value in data:
+        crc ^= value << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+def read_varint(data):
+    value = 0
+    shift = 0
+    for position, byte in enumerate(data):
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, position + 1
+    raise ValueError()
+
+def format_values(payload, sensor_format, sign, precision):
+    width = (sensor_format['i'] + sensor_format['q']) // 8
+    code = {1: 'b', 2: 'h', 4: 'i'}[width]
+    values = struct.unpack(f'<{sensor_format["n"]}{code}', payload[:width * sensor_format['n']])
+    q = sensor_format['q']
+    mul = 10 ** precision
+    parts = []
+
+    for value in values:
+        # Same integer arithmetic as applyDataFormatDecimal
+        absolute = -value if value < 0 else value
+        integer = absolute >> q
+        decimal = ((absolute & ((1 << q) - 1)) * mul) >> q
+
+        text = ('-' if value < 0 else ' ') if sign else ''
+        text += str(integer)
+        if precision:
+            text += '.' + str(decimal).zfill(precision)
+        parts.append(text)
+
+    return ' '.join(parts)
+
+class Decoder:
+    def __init__(self, output):
+        self.output = output
+        self.buffer = bytearray()
+        self.formats = {}
+        self.sequence = None
+        self.timestamp = 0
+        self.errors = 0
+        self.lost = 0
+
+    def feed(self, data):
+        self.buffer.extend(data)
+
+        while True:
+            start = self.buffer.find(bytes([FRAME_SYNC]))
+            if start < 0:
+                self.buffer.clear()
+                return
+            del self.buffer[:start]
+
+            if len(self.buffer) < HEADER_SIZE:
+                return
+            length = HEADER_SIZE + self.buffer[4] + CRC_SIZE
+            if len(self.buffer) < length:
+                return
+
+            frame = bytes(self.buffer[:length])
+            crc = frame[-2] | (frame[-1] << 8)
+
+            if calc_crc16(frame[1:-2]) != crc:
+                # Resynchronize on the next sync byte
+                self.errors += 1
+                del self.buffer[:1]
+                continue
+
+            del self.buffer[:length]
+            self.handle_frame(frame[1], frame[2], frame[3], frame[HEADER_SIZE:-2])
+
+    def handle_frame(self, frame_type, sequence, tag, payload):
+        if self.sequence is not None:
+            self.lost += (sequence - self.sequence - 1) & 0xFF
+        self.sequence = sequence
+
+        if frame_type == FRAME_FORMAT:
+            timestamp, sensor_type, i, q, n = struct.unpack('<IBBBB', payload)
+            self.timestamp = timestamp
+            self.formats[tag] = {'type': sensor_type, 'i': i, 'q': q, 'n': n}
+        elif frame_type == FRAME_DATA:
+            delta, offset = read_varint(payload)
+            self.timestamp = (self.timestamp + delta) & 0xFFFFFFFF
+
+            if tag not in self.formats:
+                return
+
+            sensor_format = self.formats[tag]
+            prefix, suffix, sign, precision = TEXT_FORMATS[sensor_format['type']]
+            text = prefix.format(timestamp=self.timestamp)
+            text += format_values(payload[offset:], sensor_format, sign, precision)
+            text += suffix
+            self.output.write(text + '\r\n')
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--stats', dest='stats', help='print frame statistics at the end',
+                        default=False, action='store_true')
+    parser.add_argument(dest='input', nargs='?', help='input file, standard input by default',
+                        default='')
+    options = parser.parse_args()
+
+    decoder = Decoder(sys.stdout)
+    stream = open(options.input, 'rb') if options.input else sys.stdin.buffer
+
+    try:
+        while True:
+            data = stream.read1(4096) if hasattr(stream, 'read1') else stream.read(4096)
+            if not data:
+                break
+            decoder.feed(data)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+    if options.stats:
+        sys.stderr.write(f'CRC errors: {decoder.errors}, lost frames: {decoder.lost}\n')
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# dfu_benchmark.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+'''Measure firmware update time of DFU bootloaders.
+
+This module downloads random images of several sizes with dfu-util
+and prints total update time and average download rate for each size.
+'''
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+DEFAULT_SIZES = [131072, 1048576, 4194304]
+
+def parse_size(text):
+    suffixes = {'k': 1024, 'm': 1024 * 1024}
+    multiplier = suffixes.get(text[-1].lower(), 1)
+    return int(text[:-1] if multiplier > 1 else text) * multiplier
+
+def run_download(options, path):
+    command = [options.tool, '-a', str(options.alt), '-D', path]
+    if options.device:
+        command.extend(['-d', options.device])
+
+    start = time.monotonic()
+    result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                            check=False)
+    elapsed = time.monotonic() - start
+
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr.decode(errors='replace'))
+        return None
+    return elapsed
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-a', dest='alt', help='alternate setting', default=0, type=int)
+    parser.add_argument('-d', dest='device', help='vendor and product IDs, vid:pid',
+                        default='')
+    parser.add_argument('-n', dest='count', help='number of downloads for each size',
+                        default=1, type=int)
+    parser.add_argument('--tool', dest='tool', help='path to dfu-util', default='dfu-util')
+    parser.add_argument(dest='sizes', nargs='*', help='image sizes, suffixes K and M allowed',
+                        default=[])
+    options = parser.parse_args()
+
+    sizes = [parse_size(size) for size in options.sizes] if options.sizes else DEFAULT_SIZES
+
+    print('size,B time,s rate,B/s')
+    for size in sizes:
+        with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as image:
+            image.write(os.urandom(size))
+            path = image.name
+
+        try:
+            for _ in range(options.count):
+                elapsed = run_download(options, path)
+                if elapsed is None:
+                    sys.exit(1)
+                print(f'{size} {elapsed:.3f} {int(size / elapsed)}')
+                sys.stdout.flush()
+        finally:
+            os.remove(path)
+
+if __name__ == '__main__':
+    main()
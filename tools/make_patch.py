@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# make_patch.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+'''Make patches for firmware images installed by DFU bootloaders.
+
+This module builds a patch that converts the installed firmware image
+into a new one. The bootloader rebuilds the new image in place sector
+by sector, so unchanged sectors are neither erased nor programmed.
+The patch format:
+    header: magic "DPMD", 32-bit little-endian size of the new image,
+        size and CRC-32 of the installed image, CRC-32 of the new image,
+    commands: LEB128 number with the length shifted left by one,
+        the lowest bit is 1 for insertion and 0 for copying,
+    insertion: command followed by the inserted data,
+    copying: command followed by LEB128 position in the installed image.
+Copying never references sectors rewritten before the current one.
+Patches can be compressed further with pack_firmware.py.
+'''
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b'DPMD'
+# Length of the prefix used for match lookup
+KEY_LENGTH = 8
+# Copying shorter sequences takes more space than insertion
+COPY_MIN = 12
+# Number of candidate positions checked for each match
+CHAIN_LIMIT = 32
+
+def encode_varint(value):
+    output = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            output.append(byte | 0x80)
+        else:
+            output.append(byte)
+            return bytes(output)
+
+def decode_varint(data, position):
+    value, shift = 0, 0
+    while True:
+        byte = data[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, position
+
+class Differ:
+    def __init__(self, old, new, sector):
+        self.old = old
+        self.new = new
+        self.sector = sector
+        self.unchanged = set()
+        self.index = {}
+
+        for number in range((len(new) + sector - 1) // sector):
+            start = number * sector
+            end = min(start + sector, len(new))
+            if old[start:end] == new[start:end]:
+                self.unchanged.add(number)
+
+        for position in range(len(old) - KEY_LENGTH + 1):
+            key = old[position:position + KEY_LENGTH]
+            self.index.setdefault(key, []).append(position)
+
+    def is_available(self, source, target):
+        # Old sector is available until it is rewritten after the target sector
+        source_sector = source // self.sector
+        return source_sector >= target // self.sector or source_sector in self.unchanged
+
+    def match_length(self, source, target):
+        length = 0
+        while (target + length < len(self.new) and source + length < len(self.old)
+               and self.old[source + length] == self.new[target + length]
+               and self.is_available(source + length, target + length)):
+            length += 1
+        return length
+
+    def find_match(self, target):
+        # Data at the same position is the most probable match
+        candidates = [target] if target < len(self.old) else []
+        key = self.new[target:target + KEY_LENGTH]
+        candidates.extend(self.index.get(key, [])[:CHAIN_LIMIT])
+
+        best_length, best_source = 0, 0
+        for source in candidates:
+            length = self.match_length(source, target)
+            if length > best_length:
+                best_length, best_source = length, source
+        return best_length, best_source
+
+    def make(self):
+        commands = bytearray()
+        literals = bytearray()
+        position = 0
+
+        def flush_literals():
+            if literals:
+                commands.extend(encode_varint(len(literals) << 1 | 1))
+                commands.extend(literals)
+                literals.clear()
+
+        while position < len(self.new):
+            length, source = self.find_match(position)
+            if length >= COPY_MIN:
+                flush_literals()
+                commands.extend(encode_varint(length << 1))
+                commands.extend(encode_varint(source))
+                position += length
+            else:
+                literals.append(self.new[position])
+                position += 1
+        flush_literals()
+
+        header = MAGIC + struct.pack('<IIII', len(self.new), len(self.old),
+                                     zlib.crc32(self.old), zlib.crc32(self.new))
+        return header + bytes(commands)
+
+def apply_patch(old, patch, sector):
+    '''Apply the patch in place the same way as the bootloader does.'''
+    if patch[:len(MAGIC)] != MAGIC:
+        raise ValueError('incorrect magic number')
+
+    length, old_length, old_crc, new_crc = struct.unpack('<IIII', patch[4:20])
+    if len(old) < old_length or zlib.crc32(old[:old_length]) != old_crc:
+        raise ValueError('installed image does not match the patch')
+
+    memory = bytearray(old) + bytearray(max(0, length - len(old)))
+    buffer = bytearray()
+    produced = 0
+    position = 20
+
+    def flush():
+        nonlocal buffer
+        start = produced - len(buffer)
+        memory[start:produced] = buffer
+        buffer = bytearray()
+
+    while produced < length:
+        command, position = decode_varint(patch, position)
+        count = command >> 1
+
+        if command & 1:
+            source = None
+            data = patch[position:position + count]
+            position += count
+        else:
+            source, position = decode_varint(patch, position)
+
+        for i in range(count):
+            # Copied data is read after the previous sectors are rewritten
+            buffer.append(data[i] if source is None else memory[source + i])
+            produced += 1
+            if produced % sector == 0 or produced == length:
+                flush()
+
+    result = bytes(memory[:length])
+    if zlib.crc32(result) != new_crc:
+        raise ValueError('checksum mismatch')
+    return result
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-o', dest='output', help='output file', required=True)
+    parser.add_argument('-s', dest='sector', help='sector size of the memory',
+                        default=4096, type=int)
+    parser.add_argument(dest='old', help='installed image')
+    parser.add_argument(dest='new', help='new image')
+    options = parser.parse_args()
+
+    with open(options.old, 'rb') as stream:
+        old = stream.read()
+    with open(options.new, 'rb') as stream:
+        new = stream.read()
+
+    patch = Differ(old, new, options.sector).make()
+    if apply_patch(old, patch, options.sector) != new:
+        sys.stderr.write('Verification failed\n')
+        sys.exit(1)
+
+    with open(options.output, 'wb') as stream:
+        stream.write(patch)
+
+    sectors = (len(new) + options.sector - 1) // options.sector
+    changed = sum(1 for number in range(sectors)
+                  if old[number * options.sector:(number + 1) * options.sector]
+                  != new[number * options.sector:(number + 1) * options.sector])
+    print(f'{len(new)} -> {len(patch)} bytes, {changed} of {sectors} sectors changed')
+
+if __name__ == '__main__':
+    main()
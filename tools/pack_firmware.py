@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# pack_firmware.py
+# Copyright (C) 2026 xent
+# Project is distributed under the terms of the GNU General Public License v3.0
+
+'''Pack firmware images for DFU bootloaders.
+
+This module compresses raw firmware images into the format decoded
+by DFU bootloaders while the image is being downloaded. The format is
+an LZSS stream with a 4 KiB window:
+    header: magic "DPMZ" and 32-bit little-endian size of the raw image,
+    groups: control byte followed by 8 items, lowest bit first,
+    item with bit 1: literal byte,
+    item with bit 0: two bytes with 12-bit distance minus 1
+        and 4-bit length minus 3, the distance high bits go first
+        in the upper half of the second byte.
+'''
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'DPMZ'
+WINDOW_SIZE = 4096
+MATCH_MIN = 3
+MATCH_MAX = 18
+# Number of candidate positions checked for each match
+CHAIN_LIMIT = 64
+
+def find_match(data, position, chains):
+    key = data[position:position + MATCH_MIN]
+    best_length, best_distance = 0, 0
+
+    if len(key) < MATCH_MIN:
+        return best_length, best_distance
+
+    limit = min(MATCH_MAX, len(data) - position)
+    for candidate in reversed(chains.get(key, [])[-CHAIN_LIMIT:]):
+        distance = position - candidate
+        if distance > WINDOW_SIZE:
+            break
+
+        length = MATCH_MIN
+        while length < limit and data[candidate + length] == data[position + length]:
+            length += 1
+        if length > best_length:
+            best_length, best_distance = length, distance
+            if length == limit:
+                break
+
+    return best_length, best_distance
+
+def pack(data):
+    output = bytearray(MAGIC + struct.pack('<I', len(data)))
+    chains = {}
+    position = 0
+
+    def insert(index):
+        key = bytes(data[index:index + MATCH_MIN])
+        if len(key) == MATCH_MIN:
+            chains.setdefault(key, []).append(index)
+
+    while position < len(data):
+        control_index = len(output)
+        output.append(0)
+        control = 0
+
+        for item in range(8):
+            if position >= len(data):
+                break
+
+            length, distance = find_match(data, position, chains)
+            if length >= MATCH_MIN:
+                value = distance - 1
+                output.append(value & 0xFF)
+                output.append(((value >> 4) & 0xF0) | (length - MATCH_MIN))
+            else:
+                control |= 1 << item
+                output.append(data[position])
+                length = 1
+
+            for index in range(position, position + length):
+                insert(index)
+            position += length
+
+        output[control_index] = control
+
+    return bytes(output)
+
+def unpack(data):
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError('incorrect magic number')
+
+    length = struct.unpack('<I', data[4:8])[0]
+    output = bytearray()
+    position = 8
+
+    while len(output) < length:
+        control = data[position]
+        position += 1
+
+        for item in range(8):
+            if len(output) >= length:
+                break
+
+            if control & (1 << item):
+                output.append(data[position])
+                position += 1
+            else:
+                value = data[position] | (data[position + 1] & 0xF0) << 4
+                count = (data[position + 1] & 0x0F) + MATCH_MIN
+                position += 2
+
+                distance = value + 1
+                if distance > len(output):
+                    raise ValueError('reference outside of the decoded data')
+                for _ in range(min(count, length - len(output))):
+                    output.append(output[-distance])
+
+    return bytes(output)
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-d', dest='decompress', help='unpack a compressed image',
+                        default=False, action='store_true')
+    parser.add_argument('-o', dest='output', help='output file', required=True)
+    parser.add_argument(dest='input', help='input file')
+    options = parser.parse_args()
+
+    with open(options.input, 'rb') as stream:
+        data = stream.read()
+
+    if options.decompress:
+        result = unpack(data)
+    else:
+        result = pack(data)
+        if unpack(result) != data:
+            sys.stderr.write('Verification failed\n')
+            sys.exit(1)
+
+    with open(options.output, 'wb') as stream:
+        stream.write(result)
+
+    if not options.decompress:
+        ratio = len(result) * 100 / len(data) if data else 0
+        print(f'{len(data)} -> {len(result)} bytes, {ratio:.1f}%')
+
+if __name__ == '__main__':
+    main()